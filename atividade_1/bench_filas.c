@@ -0,0 +1,414 @@
+/*
+ * Bancada de medição para as variantes de produtor-consumidor desta atividade.
+ * Os programas da atividade dormem `random() % 3` segundos por item, o que impede medir
+ * qualquer coisa. Aqui cada variante roda com a mesma carga: um número fixo de itens,
+ * e, no lugar das pausas, um trabalho ocupado calibrado (ou nenhum trabalho) antes de
+ * produzir e depois de consumir cada item.
+ *
+ * Variantes (reimplementadas com as mesmas estruturas dos programas de origem):
+ * - semaforo: buffer circular com os semáforos pos_vazia e pos_ocupada (semaforo.c);
+ * - espera_ocupada: contador `cont` atômico e espera só girando (produtor_consumidor_espera_ocupada.c,
+ *   sem a condição de corrida sobre `cont`);
+ * - espera_adaptativa: o mesmo, com a espera em giro, cessão e futex de espera.h;
+ * - spsc e spsc_lote: fila sem travas de fila_spsc.h, item a item e em lotes de `-l`;
+ * - mpmc: fila de fila_mpmc.h com um produtor e um consumidor.
+ *
+ * Para cada variante são exibidos:
+ * - itens/s (tempo real) e tempo de CPU do processo;
+ * - percentis da latência de cada item, do instante em que o produtor o tem pronto
+ *   (antes de esperar por espaço na fila) até o instante em que o consumidor o retira.
+ *   Os instantes ficam em dois vetores indexados pelo item, fora da fila, e as
+ *   diferenças são ordenadas ao final;
+ * - trocas de contexto voluntárias e involuntárias (getrusage).
+ *
+ * Compilação: gcc -O2 -pthread -o bench_filas bench_filas.c
+ * Uso: ./bench_filas [-n itens] [-t ns] [-l lote] [-v variante,...]
+ *   -n: itens por variante (padrão: 1000000)
+ *   -t: trabalho ocupado por item, em nanossegundos, de cada lado (padrão: 0)
+ *   -l: tamanho do lote de spsc_lote (padrão: 16, no máximo N_ITENS)
+ *   -v: variantes a medir, separadas por vírgula (padrão: todas)
+ *
+ * Com um único núcleo, espera_ocupada só avança quando o escalonador tira a thread que
+ * está girando do processador; use -n pequeno ou deixe essa variante de fora.
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>      // Biblioteca para manipulação de threads.
+#include <stdio.h>        // Biblioteca padrão para entrada e saída.
+#include <stdlib.h>       // Para malloc, qsort e atol.
+#include <string.h>       // Para strtok e strcmp.
+#include <unistd.h>       // Para getopt.
+#include <limits.h>       // Para INT_MAX.
+#include <time.h>         // Para clock_gettime.
+#include <semaphore.h>    // Biblioteca para manipulação de semáforos.
+#include <sys/resource.h> // Para getrusage.
+#include "espera.h"       // Espera adaptativa (giro, cessão e futex).
+#include "fila_spsc.h"    // Fila sem travas para um produtor e um consumidor.
+#include "fila_mpmc.h"    // Fila limitada para vários produtores e consumidores.
+
+#define N_ITENS 32
+// Tamanho do buffer circular de todas as variantes (potência de 2, exigida pela fila MPMC).
+
+long total_itens = 1000000;
+long trabalho_ns = 0;
+long lote = 16;
+
+long unidades_trabalho = 0;
+// Iterações de trabalho_ocupado equivalentes a `trabalho_ns` (ver calibrar_trabalho).
+
+long long *instante_insercao, *instante_remocao;
+// Instante (ns) em que cada item entrou e saiu da fila, indexados pelo item.
+
+long erros = 0;
+// Itens recebidos fora de ordem (deve terminar em 0 em todas as variantes).
+
+static inline long long agora_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+static void trabalho_ocupado(long unidades) {
+    volatile unsigned x = 1;
+    long i;
+    for (i = 0; i < unidades; i++) {
+        x = x * 1103515245u + 12345u;
+    }
+}
+
+// Mede o custo de uma iteração de trabalho_ocupado em tempo de CPU da thread, que não
+// conta o tempo em que a máquina virtual ou outros processos ocupam o núcleo.
+static void calibrar_trabalho(void) {
+    struct timespec t0, t1;
+    long unidades = 10000000;
+    double ns;
+    if (trabalho_ns <= 0) return;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t0);
+    trabalho_ocupado(unidades);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t1);
+    ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+    unidades_trabalho = (long)(trabalho_ns * unidades / ns);
+    if (unidades_trabalho < 1) unidades_trabalho = 1;
+    printf("Trabalho por item: %ld ns (%ld iterações, %.2f ns cada).\n", trabalho_ns, unidades_trabalho, ns / unidades);
+}
+
+// Marcações comuns a todas as variantes. O instante de inserção é tomado depois do
+// trabalho do item e antes de qualquer tentativa de inseri-lo (inclusive a reserva do
+// lote): a latência inclui a espera do produtor por espaço na fila, o tempo na fila e
+// a demora do consumidor em retirá-lo, mas não o trabalho de nenhum dos lados.
+static inline void antes_de_inserir(long i) {
+    trabalho_ocupado(unidades_trabalho);
+    instante_insercao[i] = agora_ns();
+}
+
+static inline void depois_de_remover(long i, int item) {
+    instante_remocao[item] = agora_ns();
+    if (item != (int)i) erros++;
+    trabalho_ocupado(unidades_trabalho);
+}
+
+/* ---- semaforo: buffer circular com dois semáforos ---- */
+
+int buffer[N_ITENS];
+int inicio = 0, final = 0;
+sem_t pos_vazia, pos_ocupada;
+
+static void semaforo_iniciar(void) {
+    inicio = final = 0;
+    sem_init(&pos_vazia, 0, N_ITENS);
+    sem_init(&pos_ocupada, 0, 0);
+}
+
+static void semaforo_inserir(int item) {
+    sem_wait(&pos_vazia);
+    buffer[final] = item;
+    final = (final + 1) % N_ITENS;
+    sem_post(&pos_ocupada);
+}
+
+static int semaforo_remover(void) {
+    int item;
+    sem_wait(&pos_ocupada);
+    item = buffer[inicio];
+    inicio = (inicio + 1) % N_ITENS;
+    sem_post(&pos_vazia);
+    return item;
+}
+
+static void semaforo_finalizar(void) {
+    sem_destroy(&pos_vazia);
+    sem_destroy(&pos_ocupada);
+}
+
+/* ---- espera_ocupada e espera_adaptativa: contador `cont` atômico ---- */
+
+int cont = 0;
+EsperaAdaptativa espera;
+
+static void espera_ocupada_iniciar(void) {
+    inicio = final = cont = 0;
+    espera_iniciar(&espera, INT_MAX, 0, 0); // Só gira: nunca cede o processador nem dorme
+}
+
+static void espera_adaptativa_iniciar(void) {
+    inicio = final = cont = 0;
+    espera_iniciar(&espera, ESPERA_GIROS_PADRAO, ESPERA_CESSOES_PADRAO, 0);
+}
+
+static void cont_inserir(int item) {
+    espera_enquanto_igual(&espera, &cont, N_ITENS);
+    buffer[final] = item;
+    final = (final + 1) % N_ITENS;
+    __atomic_fetch_add(&cont, 1, __ATOMIC_RELEASE);
+    espera_acordar(&espera, &cont);
+}
+
+static int cont_remover(void) {
+    int item;
+    espera_enquanto_igual(&espera, &cont, 0);
+    item = buffer[inicio];
+    inicio = (inicio + 1) % N_ITENS;
+    __atomic_fetch_sub(&cont, 1, __ATOMIC_RELEASE);
+    espera_acordar(&espera, &cont);
+    return item;
+}
+
+/* ---- spsc e spsc_lote ---- */
+
+FilaSpsc fila_spsc;
+
+static void spsc_variante_iniciar(void) {
+    spsc_iniciar(&fila_spsc, buffer, N_ITENS);
+}
+
+static void spsc_variante_inserir(int item) {
+    spsc_inserir(&fila_spsc, item);
+}
+
+static int spsc_variante_remover(void) {
+    return spsc_remover(&fila_spsc);
+}
+
+// No lote, o trabalho e as marcações continuam sendo por item; só a sincronização é por
+// lote. Os itens do lote são marcados antes da reserva, como nas variantes item a item.
+static void* spsc_lote_produtor(void *v) {
+    long i = 0;
+    while (i < total_itens) {
+        uint64_t k = total_itens - i < lote ? (uint64_t)(total_itens - i) : (uint64_t)lote, j;
+        uint64_t publicados = 0;
+        for (j = 0; j < k; j++) {
+            antes_de_inserir(i + j);
+        }
+        while (publicados < k) {
+            // A reserva pode vir menor que o pedido (fila quase cheia ou fim do buffer)
+            int *posicoes;
+            uint64_t m = spsc_reservar(&fila_spsc, k - publicados, &posicoes);
+            if (m == 0) {
+                sched_yield();
+                continue;
+            }
+            for (j = 0; j < m; j++) {
+                posicoes[j] = (int)(i + publicados + j);
+            }
+            spsc_publicar(&fila_spsc, m);
+            publicados += m;
+        }
+        i += k;
+    }
+    return NULL;
+}
+
+static void* spsc_lote_consumidor(void *v) {
+    long i = 0;
+    while (i < total_itens) {
+        const int *itens;
+        uint64_t k = spsc_espiar(&fila_spsc, (uint64_t)lote, &itens), j;
+        if (k == 0) {
+            sched_yield();
+            continue;
+        }
+        for (j = 0; j < k; j++) {
+            depois_de_remover(i + j, itens[j]);
+        }
+        spsc_liberar(&fila_spsc, k);
+        i += k;
+    }
+    return NULL;
+}
+
+/* ---- mpmc com um produtor e um consumidor ---- */
+
+FilaMpmc fila_mpmc;
+
+static void mpmc_variante_iniciar(void) {
+    if (mpmc_criar(&fila_mpmc, N_ITENS) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a fila!\n");
+        exit(1);
+    }
+}
+
+static void mpmc_variante_inserir(int item) {
+    mpmc_inserir(&fila_mpmc, item);
+}
+
+static int mpmc_variante_remover(void) {
+    return mpmc_remover(&fila_mpmc);
+}
+
+static void mpmc_variante_finalizar(void) {
+    mpmc_destruir(&fila_mpmc);
+}
+
+/* ---- Execução ---- */
+
+typedef struct {
+    const char *nome;
+    void (*iniciar)(void);
+    void (*finalizar)(void);      // Pode ser NULL
+    void (*inserir)(int item);
+    int (*remover)(void);
+    void* (*produtor)(void *);    // Laços próprios (NULL: produtor_item e consumidor_item)
+    void* (*consumidor)(void *);
+} Variante;
+
+Variante variantes[] = {
+    {"semaforo", semaforo_iniciar, semaforo_finalizar, semaforo_inserir, semaforo_remover, NULL, NULL},
+    {"espera_ocupada", espera_ocupada_iniciar, NULL, cont_inserir, cont_remover, NULL, NULL},
+    {"espera_adaptativa", espera_adaptativa_iniciar, NULL, cont_inserir, cont_remover, NULL, NULL},
+    {"spsc", spsc_variante_iniciar, NULL, spsc_variante_inserir, spsc_variante_remover, NULL, NULL},
+    {"spsc_lote", spsc_variante_iniciar, NULL, NULL, NULL, spsc_lote_produtor, spsc_lote_consumidor},
+    {"mpmc", mpmc_variante_iniciar, mpmc_variante_finalizar, mpmc_variante_inserir, mpmc_variante_remover, NULL, NULL},
+};
+
+#define N_VARIANTES (int)(sizeof(variantes) / sizeof(variantes[0]))
+
+Variante *atual;
+
+static void* produtor_item(void *v) {
+    long i;
+    for (i = 0; i < total_itens; i++) {
+        antes_de_inserir(i);
+        atual->inserir((int)i);
+    }
+    return NULL;
+}
+
+static void* consumidor_item(void *v) {
+    long i;
+    for (i = 0; i < total_itens; i++) {
+        depois_de_remover(i, atual->remover());
+    }
+    return NULL;
+}
+
+static int comparar_latencias(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil p (0 a 100) de `n` valores já ordenados
+static long long percentil(const long long *valores, long n, double p) {
+    long i = (long)(p / 100.0 * (n - 1) + 0.5);
+    return valores[i];
+}
+
+static double segundos_rusage(struct timeval t) {
+    return t.tv_sec + t.tv_usec / 1e6;
+}
+
+static void medir_variante(Variante *v) {
+    pthread_t thr_produtor, thr_consumidor;
+    struct rusage r0, r1;
+    long long t0, t1, *latencias = instante_remocao;
+    double segundos, cpu;
+    long i;
+
+    atual = v;
+    erros = 0;
+    v->iniciar();
+
+    getrusage(RUSAGE_SELF, &r0);
+    t0 = agora_ns();
+    pthread_create(&thr_consumidor, NULL, v->consumidor ? v->consumidor : consumidor_item, NULL);
+    pthread_create(&thr_produtor, NULL, v->produtor ? v->produtor : produtor_item, NULL);
+    pthread_join(thr_produtor, NULL);
+    pthread_join(thr_consumidor, NULL);
+    t1 = agora_ns();
+    getrusage(RUSAGE_SELF, &r1);
+
+    if (v->finalizar) v->finalizar();
+
+    // As latências substituem os instantes de remoção, que não são mais necessários
+    for (i = 0; i < total_itens; i++) {
+        latencias[i] = instante_remocao[i] - instante_insercao[i];
+    }
+    qsort(latencias, total_itens, sizeof(long long), comparar_latencias);
+
+    segundos = (t1 - t0) / 1e9;
+    cpu = segundos_rusage(r1.ru_utime) - segundos_rusage(r0.ru_utime)
+        + segundos_rusage(r1.ru_stime) - segundos_rusage(r0.ru_stime);
+    printf("%-18s %12.0f %8.3f %9lld %9lld %9lld %9lld %11lld %10ld %10ld\n",
+           v->nome, total_itens / segundos, cpu,
+           percentil(latencias, total_itens, 50), percentil(latencias, total_itens, 90),
+           percentil(latencias, total_itens, 99), percentil(latencias, total_itens, 99.9),
+           latencias[total_itens - 1],
+           r1.ru_nvcsw - r0.ru_nvcsw, r1.ru_nivcsw - r0.ru_nivcsw);
+    if (erros > 0) {
+        printf("Erro: %ld itens recebidos fora de ordem em %s.\n", erros, v->nome);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    char *lista = NULL, *nome;
+    int opcao, i, escolhidas[N_VARIANTES] = {0}, algum_erro = 0;
+
+    while ((opcao = getopt(argc, argv, "n:t:l:v:")) != -1) {
+        switch (opcao) {
+        case 'n': total_itens = atol(optarg); break;
+        case 't': trabalho_ns = atol(optarg); break;
+        case 'l': lote = atol(optarg); break;
+        case 'v': lista = optarg; break;
+        default:
+            fprintf(stderr, "Uso: %s [-n itens] [-t ns] [-l lote] [-v variante,...]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (total_itens <= 0 || total_itens > INT_MAX || trabalho_ns < 0 || lote < 1 || lote > N_ITENS) {
+        fprintf(stderr, "Erro: Use de 1 a %d itens, trabalho >= 0 e lote de 1 a %d.\n", INT_MAX, N_ITENS);
+        return 1;
+    }
+    if (lista == NULL) {
+        for (i = 0; i < N_VARIANTES; i++) escolhidas[i] = 1;
+    } else {
+        for (nome = strtok(lista, ","); nome != NULL; nome = strtok(NULL, ",")) {
+            for (i = 0; i < N_VARIANTES && strcmp(variantes[i].nome, nome) != 0; i++);
+            if (i == N_VARIANTES) {
+                fprintf(stderr, "Erro: Variante desconhecida: %s.\n", nome);
+                return 1;
+            }
+            escolhidas[i] = 1;
+        }
+    }
+
+    instante_insercao = (long long *)malloc(total_itens * sizeof(long long));
+    instante_remocao = (long long *)malloc(total_itens * sizeof(long long));
+    if (instante_insercao == NULL || instante_remocao == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para os instantes!\n");
+        return 1;
+    }
+    calibrar_trabalho();
+
+    printf("%ld itens por variante, buffer de %d posições, lote %ld.\n", total_itens, N_ITENS, lote);
+    printf("%-18s %12s %8s %9s %9s %9s %9s %11s %10s %10s\n", "Variante", "Itens/s", "CPU (s)",
+           "p50 (ns)", "p90", "p99", "p99.9", "Max", "Trocas vol", "Trocas inv");
+    for (i = 0; i < N_VARIANTES; i++) {
+        if (!escolhidas[i]) continue;
+        medir_variante(&variantes[i]);
+        algum_erro |= erros > 0;
+    }
+
+    free(instante_insercao);
+    free(instante_remocao);
+    return algum_erro;
+}
@@ -0,0 +1,94 @@
+/*
+ * Espera adaptativa: gira, depois cede o processador, depois dorme.
+ * Substitui a espera ocupada `while (cont == N_ITENS);`, que mantém um núcleo a 100%
+ * enquanto o outro lado está lento. espera_enquanto_igual(e, &cont, N_ITENS) passa por
+ * três fases enquanto o valor não muda:
+ * 1. até `giros` leituras seguidas, com a instrução de pausa da CPU entre elas (o
+ *    núcleo gasta menos energia e não atrapalha o outro hyperthread): se o outro lado
+ *    responde em poucos microssegundos, a latência é a da espera ocupada;
+ * 2. até `cessoes` chamadas a sched_yield, que deixam outra thread usar o núcleo;
+ * 3. dorme em um futex sobre o próprio endereço, sem consumir CPU, até que o outro lado
+ *    chame espera_acordar depois de alterar o valor.
+ *
+ * espera_acordar só faz a chamada ao sistema (FUTEX_WAKE) se alguém estiver dormindo,
+ * então, com tráfego intenso, nenhum dos lados entra no kernel. O contador `dormindo` e
+ * a barreira em espera_acordar garantem que um despertar não se perde: ou quem altera o
+ * valor vê a thread dormindo e a acorda, ou a thread vê o valor novo ao entrar no futex
+ * (FUTEX_WAIT só dorme se o endereço ainda contém o valor esperado).
+ *
+ * Com `compartilhado` = 1 o futex funciona entre processos (memória de mmap com
+ * MAP_SHARED); caso contrário, usa as operações privadas, mais baratas.
+ *
+ * Uso: basta incluir este arquivo; as funções são `static inline` (somente Linux).
+ */
+
+#ifndef ESPERA_H
+#define ESPERA_H
+
+#include <stdatomic.h>     // Para atomic_fetch_add, atomic_thread_fence
+#include <limits.h>        // Para INT_MAX
+#include <sched.h>         // Para sched_yield
+#include <unistd.h>        // Para syscall
+#include <sys/syscall.h>   // Para SYS_futex
+#include <linux/futex.h>   // Para FUTEX_WAIT, FUTEX_WAKE
+
+#define ESPERA_GIROS_PADRAO 2000  // Leituras com pausa antes de ceder o processador
+#define ESPERA_CESSOES_PADRAO 4   // Chamadas a sched_yield antes de dormir
+
+typedef struct {
+    int giros;              // Orçamento da fase 1 (0: pula a fase)
+    int cessoes;            // Orçamento da fase 2 (0: pula a fase)
+    int compartilhado;      // 1 se o endereço esperado é compartilhado entre processos
+    _Atomic int dormindo;   // Threads dormindo no futex agora
+    _Atomic long dormidas;  // Vezes em que alguma thread precisou dormir (estatística)
+} EsperaAdaptativa;
+
+static inline void espera_iniciar(EsperaAdaptativa *e, int giros, int cessoes, int compartilhado) {
+    e->giros = giros;
+    e->cessoes = cessoes;
+    e->compartilhado = compartilhado;
+    atomic_init(&e->dormindo, 0);
+    atomic_init(&e->dormidas, 0);
+}
+
+// Dica para a CPU de que esta é uma espera ocupada
+static inline void espera_pausa(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static inline int espera_ler(int *endereco) {
+    return __atomic_load_n(endereco, __ATOMIC_ACQUIRE);
+}
+
+// Espera enquanto *endereco == valor (ver as três fases no comentário do topo)
+static inline void espera_enquanto_igual(EsperaAdaptativa *e, int *endereco, int valor) {
+    int i;
+    for (i = 0; i < e->giros; i++) {
+        if (espera_ler(endereco) != valor) return;
+        espera_pausa();
+    }
+    for (i = 0; i < e->cessoes; i++) {
+        if (espera_ler(endereco) != valor) return;
+        sched_yield();
+    }
+    while (espera_ler(endereco) == valor) {
+        atomic_fetch_add(&e->dormindo, 1);
+        atomic_fetch_add_explicit(&e->dormidas, 1, memory_order_relaxed);
+        syscall(SYS_futex, endereco, e->compartilhado ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, valor, NULL, NULL, 0);
+        atomic_fetch_sub(&e->dormindo, 1);
+    }
+}
+
+// Acorda quem estiver dormindo em *endereco. Deve ser chamada depois de alterar o valor.
+static inline void espera_acordar(EsperaAdaptativa *e, int *endereco) {
+    atomic_thread_fence(memory_order_seq_cst); // O novo valor fica visível antes de ler `dormindo`
+    if (atomic_load_explicit(&e->dormindo, memory_order_relaxed) > 0) {
+        syscall(SYS_futex, endereco, e->compartilhado ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+#endif // ESPERA_H
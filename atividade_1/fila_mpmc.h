@@ -0,0 +1,127 @@
+/*
+ * Fila circular limitada para vários produtores e vários consumidores (MPMC), no
+ * estilo da fila de Dmitry Vyukov.
+ * Em semaforo.c, `inicio` e `final` só podem ser atualizados sem trava porque há
+ * exatamente uma thread de cada lado. Aqui cada posição do buffer tem um número de
+ * sequência que diz de quem é a vez de usá-la:
+ * - sequencia == pos: livre para o produtor que reservar a posição `pos`;
+ * - sequencia == pos + 1: ocupada pelo item `pos`, pronta para o consumidor;
+ * - depois do consumo, sequencia = pos + capacidade: livre para a próxima volta.
+ * Produtores disputam `final` e consumidores disputam `inicio` com compare-and-swap;
+ * quem ganha a disputa usa a posição sozinho e a libera com um store release no número
+ * de sequência. Produtores e consumidores não escrevem nas mesmas variáveis, a não ser
+ * na posição que estão trocando, e `inicio` e `final` ficam em linhas de cache separadas.
+ *
+ * A capacidade precisa ser uma potência de 2 (o índice sai de uma máscara).
+ *
+ * Uso: basta incluir este arquivo e compilar com -pthread; as funções são `static inline`.
+ */
+
+#ifndef FILA_MPMC_H
+#define FILA_MPMC_H
+
+#include <stdatomic.h> // Para atomic_load_explicit, atomic_compare_exchange_weak_explicit
+#include <stdint.h>    // Para uint64_t, int64_t
+#include <stdlib.h>    // Para malloc, free
+#include <sched.h>     // Para sched_yield
+
+#define FILA_MPMC_LINHA_CACHE 64
+
+typedef struct {
+    _Atomic uint64_t sequencia;
+    int item;
+} CelulaMpmc;
+
+typedef struct {
+    _Alignas(FILA_MPMC_LINHA_CACHE) _Atomic uint64_t final;  // Próxima posição a produzir
+    _Alignas(FILA_MPMC_LINHA_CACHE) _Atomic uint64_t inicio; // Próxima posição a consumir
+    _Alignas(FILA_MPMC_LINHA_CACHE) CelulaMpmc *celulas;     // Somente leitura depois de mpmc_criar
+    uint64_t mascara;                                         // capacidade - 1
+} FilaMpmc;
+
+// Cria a fila vazia com `capacidade` posições (potência de 2).
+// Retorna 0 ou -1 se a capacidade for inválida ou faltar memória.
+static inline int mpmc_criar(FilaMpmc *f, uint64_t capacidade) {
+    uint64_t i;
+    if (capacidade < 2 || (capacidade & (capacidade - 1)) != 0) return -1;
+    f->celulas = (CelulaMpmc *)malloc(capacidade * sizeof(CelulaMpmc));
+    if (f->celulas == NULL) return -1;
+    for (i = 0; i < capacidade; i++) {
+        atomic_init(&f->celulas[i].sequencia, i);
+    }
+    f->mascara = capacidade - 1;
+    atomic_init(&f->final, 0);
+    atomic_init(&f->inicio, 0);
+    return 0;
+}
+
+static inline void mpmc_destruir(FilaMpmc *f) {
+    free(f->celulas);
+    f->celulas = NULL;
+}
+
+// Insere o item se houver espaço. Retorna 1 se inseriu e 0 se a fila está cheia.
+static inline int mpmc_tentar_inserir(FilaMpmc *f, int item) {
+    uint64_t pos = atomic_load_explicit(&f->final, memory_order_relaxed);
+    CelulaMpmc *c;
+    for (;;) {
+        int64_t diferenca;
+        c = &f->celulas[pos & f->mascara];
+        diferenca = (int64_t)(atomic_load_explicit(&c->sequencia, memory_order_acquire) - pos);
+        if (diferenca == 0) {
+            // Posição livre nesta volta: tenta reservá-la (em caso de falha, pos é relido)
+            if (atomic_compare_exchange_weak_explicit(&f->final, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diferenca < 0) {
+            return 0; // O item da volta anterior ainda não foi consumido: fila cheia
+        } else {
+            pos = atomic_load_explicit(&f->final, memory_order_relaxed); // Outro produtor passou à frente
+        }
+    }
+    c->item = item;
+    atomic_store_explicit(&c->sequencia, pos + 1, memory_order_release);
+    return 1;
+}
+
+// Remove um item para *item. Retorna 1 se removeu e 0 se a fila está vazia.
+static inline int mpmc_tentar_remover(FilaMpmc *f, int *item) {
+    uint64_t pos = atomic_load_explicit(&f->inicio, memory_order_relaxed);
+    CelulaMpmc *c;
+    for (;;) {
+        int64_t diferenca;
+        c = &f->celulas[pos & f->mascara];
+        diferenca = (int64_t)(atomic_load_explicit(&c->sequencia, memory_order_acquire) - (pos + 1));
+        if (diferenca == 0) {
+            if (atomic_compare_exchange_weak_explicit(&f->inicio, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diferenca < 0) {
+            return 0; // O item desta posição ainda não foi produzido: fila vazia
+        } else {
+            pos = atomic_load_explicit(&f->inicio, memory_order_relaxed); // Outro consumidor passou à frente
+        }
+    }
+    *item = c->item;
+    atomic_store_explicit(&c->sequencia, pos + f->mascara + 1, memory_order_release);
+    return 1;
+}
+
+// Versões que esperam: enquanto a fila está cheia (vazia), cedem o processador
+static inline void mpmc_inserir(FilaMpmc *f, int item) {
+    while (!mpmc_tentar_inserir(f, item)) {
+        sched_yield();
+    }
+}
+
+static inline int mpmc_remover(FilaMpmc *f) {
+    int item;
+    while (!mpmc_tentar_remover(f, &item)) {
+        sched_yield();
+    }
+    return item;
+}
+
+#endif // FILA_MPMC_H
@@ -0,0 +1,163 @@
+/*
+ * Fila circular sem travas para um produtor e um consumidor (SPSC).
+ * Substitui o par de semáforos de semaforo.c (pos_vazia e pos_ocupada) por dois
+ * contadores atômicos: `final` (itens já produzidos), escrito só pelo produtor, e
+ * `inicio` (itens já consumidos), escrito só pelo consumidor. O item i ocupa a posição
+ * i % capacidade do buffer, então o buffer continua sendo um `int buffer[N_ITENS]`
+ * comum, fornecido pelo programa.
+ *
+ * - O produtor grava o item e só depois publica o novo `final` com memory_order_release;
+ *   o consumidor lê `final` com memory_order_acquire antes de ler o item. Assim o item
+ *   lido é sempre o que foi gravado, sem travas e sem chamadas ao sistema.
+ * - `inicio` e `final` ficam em linhas de cache (64 bytes) separadas: escrever um
+ *   deles não invalida a linha do outro no núcleo vizinho (falso compartilhamento).
+ * - Cada lado guarda uma cópia do contador do outro lado e só relê o contador
+ *   compartilhado quando a cópia indica fila cheia (produtor) ou vazia (consumidor).
+ *
+ * Em lote, o produtor reserva até k posições contíguas (spsc_reservar), grava os itens
+ * diretamente no buffer e publica todos com um único store release (spsc_publicar); o
+ * consumidor enxerga até k itens prontos (spsc_espiar), lê-os no próprio buffer e
+ * libera todas as posições de uma vez (spsc_liberar). A sincronização passa a custar
+ * uma leitura acquire e uma escrita release por lote, e não por item.
+ *
+ * Os contadores são de 64 bits e nunca dão a volta na prática.
+ *
+ * Uso: basta incluir este arquivo e compilar com -pthread; as funções são `static inline`.
+ */
+
+#ifndef FILA_SPSC_H
+#define FILA_SPSC_H
+
+#include <stdatomic.h> // Para atomic_load_explicit, atomic_store_explicit
+#include <stdint.h>    // Para uint64_t
+#include <sched.h>     // Para sched_yield
+
+#define FILA_SPSC_LINHA_CACHE 64
+
+typedef struct {
+    // Lado do produtor
+    _Alignas(FILA_SPSC_LINHA_CACHE) _Atomic uint64_t final; // Itens produzidos
+    uint64_t inicio_visto;     // Última leitura de `inicio` feita pelo produtor
+
+    // Lado do consumidor
+    _Alignas(FILA_SPSC_LINHA_CACHE) _Atomic uint64_t inicio; // Itens consumidos
+    uint64_t final_visto;      // Última leitura de `final` feita pelo consumidor
+
+    // Somente leitura depois de spsc_iniciar
+    _Alignas(FILA_SPSC_LINHA_CACHE) int *buffer;
+    uint64_t capacidade;
+} FilaSpsc;
+
+// Inicializa a fila vazia sobre `buffer`, que tem `capacidade` posições
+static inline void spsc_iniciar(FilaSpsc *f, int *buffer, uint64_t capacidade) {
+    atomic_init(&f->final, 0);
+    atomic_init(&f->inicio, 0);
+    f->inicio_visto = f->final_visto = 0;
+    f->buffer = buffer;
+    f->capacidade = capacidade;
+}
+
+// Produtor: insere o item se houver espaço. Retorna 1 se inseriu e 0 se a fila está cheia.
+static inline int spsc_tentar_inserir(FilaSpsc *f, int item) {
+    uint64_t final = atomic_load_explicit(&f->final, memory_order_relaxed);
+    if (final - f->inicio_visto == f->capacidade) {
+        f->inicio_visto = atomic_load_explicit(&f->inicio, memory_order_acquire);
+        if (final - f->inicio_visto == f->capacidade) return 0;
+    }
+    f->buffer[final % f->capacidade] = item;
+    atomic_store_explicit(&f->final, final + 1, memory_order_release);
+    return 1;
+}
+
+// Consumidor: remove o item mais antigo para *item. Retorna 1 se removeu e 0 se a fila está vazia.
+static inline int spsc_tentar_remover(FilaSpsc *f, int *item) {
+    uint64_t inicio = atomic_load_explicit(&f->inicio, memory_order_relaxed);
+    if (inicio == f->final_visto) {
+        f->final_visto = atomic_load_explicit(&f->final, memory_order_acquire);
+        if (inicio == f->final_visto) return 0;
+    }
+    *item = f->buffer[inicio % f->capacidade];
+    atomic_store_explicit(&f->inicio, inicio + 1, memory_order_release);
+    return 1;
+}
+
+// Versões que esperam: enquanto a fila está cheia (vazia), cede o processador ao outro lado
+static inline void spsc_inserir(FilaSpsc *f, int item) {
+    while (!spsc_tentar_inserir(f, item)) {
+        sched_yield();
+    }
+}
+
+static inline int spsc_remover(FilaSpsc *f) {
+    int item;
+    while (!spsc_tentar_remover(f, &item)) {
+        sched_yield();
+    }
+    return item;
+}
+
+// Produtor: reserva até k posições livres e contíguas no buffer (a reserva para no fim
+// do buffer, quando ele dá a volta). Retorna quantas foram reservadas, 0 se a fila está
+// cheia, e em *posicoes o endereço da primeira. Nada fica visível ao consumidor antes
+// de spsc_publicar.
+static inline uint64_t spsc_reservar(FilaSpsc *f, uint64_t k, int **posicoes) {
+    uint64_t final = atomic_load_explicit(&f->final, memory_order_relaxed);
+    uint64_t indice = final % f->capacidade;
+    uint64_t livres = f->capacidade - (final - f->inicio_visto);
+    if (livres < k) {
+        f->inicio_visto = atomic_load_explicit(&f->inicio, memory_order_acquire);
+        livres = f->capacidade - (final - f->inicio_visto);
+    }
+    if (k > livres) k = livres;
+    if (k > f->capacidade - indice) k = f->capacidade - indice;
+    *posicoes = &f->buffer[indice];
+    return k;
+}
+
+// Produtor: publica as m primeiras posições da última reserva, com um único store release
+static inline void spsc_publicar(FilaSpsc *f, uint64_t m) {
+    uint64_t final = atomic_load_explicit(&f->final, memory_order_relaxed);
+    atomic_store_explicit(&f->final, final + m, memory_order_release);
+}
+
+// Consumidor: até k itens prontos e contíguos, lidos no próprio buffer a partir de
+// *itens. Retorna quantos, 0 se a fila está vazia. As posições continuam ocupadas até
+// spsc_liberar.
+static inline uint64_t spsc_espiar(FilaSpsc *f, uint64_t k, const int **itens) {
+    uint64_t inicio = atomic_load_explicit(&f->inicio, memory_order_relaxed);
+    uint64_t indice = inicio % f->capacidade;
+    uint64_t prontos = f->final_visto - inicio;
+    if (prontos < k) {
+        f->final_visto = atomic_load_explicit(&f->final, memory_order_acquire);
+        prontos = f->final_visto - inicio;
+    }
+    if (k > prontos) k = prontos;
+    if (k > f->capacidade - indice) k = f->capacidade - indice;
+    *itens = &f->buffer[indice];
+    return k;
+}
+
+// Consumidor: devolve ao produtor as m primeiras posições do último spsc_espiar
+static inline void spsc_liberar(FilaSpsc *f, uint64_t m) {
+    uint64_t inicio = atomic_load_explicit(&f->inicio, memory_order_relaxed);
+    atomic_store_explicit(&f->inicio, inicio + m, memory_order_release);
+}
+
+// Consumidor: copia até k itens para `destino` (em no máximo duas partes, se o buffer
+// der a volta). Retorna quantos itens foram removidos, 0 se a fila está vazia.
+static inline uint64_t spsc_remover_lote(FilaSpsc *f, int *destino, uint64_t k) {
+    const int *itens;
+    uint64_t removidos = 0;
+    while (removidos < k) {
+        uint64_t m = spsc_espiar(f, k - removidos, &itens), i;
+        if (m == 0) break;
+        for (i = 0; i < m; i++) {
+            destino[removidos + i] = itens[i];
+        }
+        spsc_liberar(f, m);
+        removidos += m;
+    }
+    return removidos;
+}
+
+#endif // FILA_SPSC_H
@@ -0,0 +1,175 @@
+/*
+ * Código para vários produtores e vários consumidores com uma fila circular limitada
+ * sem travas (fila_mpmc.h, números de sequência por posição no estilo de Vyukov).
+ * Os outros programas desta atividade têm exatamente um produtor e um consumidor; aqui
+ * a quantidade de threads de cada lado é configurável.
+ *
+ * Cada produtor gera uma faixa contígua de itens (os `resto` primeiros produtores
+ * recebem um item a mais quando o total não é divisível) e cada consumidor retira uma
+ * cota fixa, calculada antes de começar, sem contador global disputado. Ao final o
+ * programa confere que todos os itens foram consumidos exatamente uma vez (pela soma)
+ * e que cada consumidor recebeu os itens de cada produtor em ordem crescente.
+ *
+ * Compilação: gcc -O2 -pthread -o produtor_consumidor_mpmc produtor_consumidor_mpmc.c
+ * Uso: ./produtor_consumidor_mpmc [-p produtores] [-c consumidores] [-n itens]
+ *   -p, -c: threads de cada lado (padrão: 1 e 1)
+ *   -n: total de itens; roda sem pausas nem impressão e mede a vazão. Sem -n, cada
+ *       produtor gera 3 * N_ITENS itens com pausas aleatórias, como semaforo.c.
+ */
+
+#include <pthread.h>  // Biblioteca para manipulação de threads.
+#include <stdio.h>    // Biblioteca padrão para entrada e saída.
+#include <stdlib.h>   // Biblioteca padrão para funções utilitárias.
+#include <unistd.h>   // Para sleep e getopt.
+#include <time.h>     // Para clock_gettime (modo de medição).
+#include "fila_mpmc.h" // Fila limitada para vários produtores e consumidores.
+
+#define N_ITENS 32
+// Tamanho do buffer circular (potência de 2, exigida pela fila MPMC).
+
+#define MAX_THREADS 256
+// Limite de threads de cada lado.
+
+FilaMpmc fila;
+int produtores = 1, consumidores = 1;
+long itens_por_produtor = 3 * N_ITENS;
+// Itens de cada produtor; os `resto` primeiros produtores geram um a mais.
+long resto = 0;
+int medir = 0;
+// 1 no modo de medição: sem pausas e sem impressão.
+
+typedef struct {
+    int id;
+    long primeiro;       // Primeiro item gerado (produtor)
+    long quantidade;     // Itens a gerar (produtor) ou a retirar (consumidor)
+    long long soma;      // Soma dos itens recebidos (consumidor)
+    long erros;          // Itens de um produtor recebidos fora de ordem (consumidor)
+    pthread_t thread;
+} Participante;
+
+Participante participantes_p[MAX_THREADS], participantes_c[MAX_THREADS];
+
+void* produtor(void *v) {
+    Participante *eu = (Participante *)v;
+    long i;
+    for (i = 0; i < eu->quantidade; i++) {
+        int item = (int)(eu->primeiro + i);
+        mpmc_inserir(&fila, item);
+        // Disputa uma posição livre com os outros produtores e publica o item nela.
+
+        if (!medir) {
+            printf("Produtor %d, item = %d.\n", eu->id, item);
+            sleep(random() % 3);
+        }
+    }
+    return NULL;
+}
+
+// Produtor que gerou `item` (inverso das faixas distribuídas em main)
+static int origem_do_item(long item) {
+    long limite = resto * (itens_por_produtor + 1);
+    if (item < limite) return (int)(item / (itens_por_produtor + 1));
+    return (int)(resto + (item - limite) / itens_por_produtor);
+}
+
+void* consumidor(void *v) {
+    Participante *eu = (Participante *)v;
+    long i;
+    long ultimo[MAX_THREADS];
+    // Último item recebido de cada produtor, para conferir a ordem (produtores <= MAX_THREADS).
+    int p;
+
+    for (p = 0; p < produtores; p++) {
+        ultimo[p] = -1;
+    }
+    for (i = 0; i < eu->quantidade; i++) {
+        // As cotas somam o total produzido, então a fila entrega cada item retirado.
+        int item = mpmc_remover(&fila);
+        int origem = origem_do_item(item);
+
+        eu->soma += item;
+        if (item <= ultimo[origem]) {
+            eu->erros++;
+        }
+        ultimo[origem] = item;
+
+        if (!medir) {
+            printf("Consumidor %d, item = %d (produtor %d).\n", eu->id, item, origem);
+            sleep(random() % 3);
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    struct timespec t0, t1;
+    long long soma = 0, esperada;
+    long erros = 0, total = 0;
+    int opcao, i;
+
+    while ((opcao = getopt(argc, argv, "p:c:n:")) != -1) {
+        switch (opcao) {
+        case 'p': produtores = atoi(optarg); break;
+        case 'c': consumidores = atoi(optarg); break;
+        case 'n': total = atol(optarg); itens_por_produtor = total; medir = 1; break;
+        default:
+            fprintf(stderr, "Uso: %s [-p produtores] [-c consumidores] [-n itens]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (produtores < 1 || produtores > MAX_THREADS || consumidores < 1 || consumidores > MAX_THREADS) {
+        fprintf(stderr, "Erro: Use de 1 a %d threads de cada lado.\n", MAX_THREADS);
+        return 1;
+    }
+    if (medir) {
+        // -n é o total de itens, dividido entre os produtores (o resto vai para os primeiros)
+        resto = total % produtores;
+        itens_por_produtor = total / produtores;
+    }
+    total = produtores * itens_por_produtor + resto;
+    if (itens_por_produtor <= 0 || total > 2147483647L) {
+        fprintf(stderr, "Erro: O total de itens deve estar entre %d e 2^31 - 1.\n", produtores);
+        return 1;
+    }
+    if (mpmc_criar(&fila, N_ITENS) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a fila!\n");
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < consumidores; i++) {
+        participantes_c[i].id = i;
+        participantes_c[i].quantidade = total / consumidores + (i < total % consumidores);
+        pthread_create(&participantes_c[i].thread, NULL, consumidor, &participantes_c[i]);
+    }
+    for (i = 0; i < produtores; i++) {
+        participantes_p[i].id = i;
+        participantes_p[i].primeiro = i * itens_por_produtor + (i < resto ? i : resto);
+        participantes_p[i].quantidade = itens_por_produtor + (i < resto);
+        pthread_create(&participantes_p[i].thread, NULL, produtor, &participantes_p[i]);
+    }
+    for (i = 0; i < produtores; i++) {
+        pthread_join(participantes_p[i].thread, NULL);
+    }
+    for (i = 0; i < consumidores; i++) {
+        pthread_join(participantes_c[i].thread, NULL);
+        soma += participantes_c[i].soma;
+        erros += participantes_c[i].erros;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    esperada = (long long)total * (total - 1) / 2;
+    if (soma != esperada) {
+        printf("Erro: A soma dos itens consumidos (%lld) difere da esperada (%lld).\n", soma, esperada);
+    }
+    if (erros > 0) {
+        printf("Erro: %ld itens recebidos fora da ordem do seu produtor.\n", erros);
+    }
+    if (medir) {
+        double segundos = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        printf("Fila MPMC (%d produtores, %d consumidores): %ld itens em %.3f s (%.0f itens/s).\n",
+               produtores, consumidores, total, segundos, total / segundos);
+    }
+    mpmc_destruir(&fila);
+    return soma != esperada || erros > 0;
+}
@@ -0,0 +1,304 @@
+/*
+ * Código para produtor e consumidor em processos separados (fork), como em pid.c, que
+ * trocam itens por um buffer circular em memória compartilhada (mmap com MAP_SHARED e
+ * MAP_ANONYMOUS, criada antes do fork e herdada pelo filho). O processo pai produz e o
+ * filho consome; os itens são gravados e lidos diretamente no buffer compartilhado,
+ * sem cópia pelo kernel.
+ *
+ * Modos (-m, separados por vírgula; padrão: todos):
+ * - semaforo: o buffer de semaforo.c com pos_vazia e pos_ocupada inicializados com
+ *   pshared = 1 dentro da memória compartilhada;
+ * - spsc: a fila sem travas de fila_spsc.h. Quando a fila está cheia (vazia), o
+ *   processo espera com espera.h em modo compartilhado (giro, cessão e, por fim, futex
+ *   entre processos) por um contador de 32 bits que o outro lado incrementa a cada item;
+ *   com tráfego intenso, nenhum item custa chamada ao sistema;
+ * - pipe: referência com um pipe, um write e um read por item.
+ *
+ * Para cada modo são exibidos itens/s, o tempo de CPU e as trocas de contexto dos dois
+ * processos (getrusage do pai e do filho). O filho confere que recebeu os itens em ordem.
+ *
+ * Compilação: gcc -O2 -pthread -o produtor_consumidor_processos produtor_consumidor_processos.c
+ * Uso: ./produtor_consumidor_processos [-n itens] [-m modo,...]
+ */
+
+#define _GNU_SOURCE
+
+#include <sys/types.h>    // Para pid_t.
+#include <sys/wait.h>     // Para waitpid.
+#include <sys/mman.h>     // Para mmap e munmap.
+#include <sys/resource.h> // Para getrusage.
+#include <stdio.h>        // Biblioteca padrão para entrada e saída.
+#include <stdlib.h>       // Para atol e exit.
+#include <string.h>       // Para strtok e strcmp.
+#include <unistd.h>       // Para fork, pipe, read, write e getopt.
+#include <limits.h>       // Para INT_MAX.
+#include <time.h>         // Para clock_gettime.
+#include <semaphore.h>    // Biblioteca para manipulação de semáforos.
+#include "espera.h"       // Espera adaptativa (giro, cessão e futex).
+#include "fila_spsc.h"    // Fila sem travas para um produtor e um consumidor.
+
+#define N_ITENS 30
+// Define o tamanho do buffer circular como 30.
+
+// Tudo o que os dois processos compartilham. Os campos escritos pelo produtor e pelo
+// consumidor ficam em linhas de cache separadas.
+typedef struct {
+    int buffer[N_ITENS];
+    FilaSpsc fila;
+
+    // Modo semaforo
+    sem_t pos_vazia, pos_ocupada;
+    int inicio, final;
+
+    // Modo spsc: contadores de 32 bits para o futex (os da fila são de 64 bits)
+    _Alignas(64) int publicados;   // Itens inseridos (escrito só pelo produtor)
+    EsperaAdaptativa espera_produtor;
+    _Alignas(64) int liberados;    // Itens removidos (escrito só pelo consumidor)
+    EsperaAdaptativa espera_consumidor;
+} Compartilhado;
+
+Compartilhado *c;
+long total_itens = 1000000;
+
+int giros = ESPERA_GIROS_PADRAO;
+// Orçamento de giro do modo spsc (0 com um único processador: ver main).
+
+/* ---- Produtor (processo pai) e consumidor (processo filho) de cada modo ---- */
+
+static void semaforo_produtor(void) {
+    long i;
+    for (i = 0; i < total_itens; i++) {
+        sem_wait(&c->pos_vazia);
+        c->buffer[c->final] = (int)i;
+        c->final = (c->final + 1) % N_ITENS;
+        sem_post(&c->pos_ocupada);
+    }
+}
+
+static long semaforo_consumidor(void) {
+    long i, erros = 0;
+    for (i = 0; i < total_itens; i++) {
+        sem_wait(&c->pos_ocupada);
+        if (c->buffer[c->inicio] != (int)i) erros++;
+        c->inicio = (c->inicio + 1) % N_ITENS;
+        sem_post(&c->pos_vazia);
+    }
+    return erros;
+}
+
+// O contador do outro lado é lido antes de tentar a fila: se a tentativa falhar, ou o
+// outro lado ainda não passou pelo item (e o contador vai mudar), ou a tentativa já o viu.
+static void spsc_produtor(void) {
+    long i;
+    for (i = 0; i < total_itens; i++) {
+        int visto = __atomic_load_n(&c->liberados, __ATOMIC_ACQUIRE);
+        while (!spsc_tentar_inserir(&c->fila, (int)i)) {
+            espera_enquanto_igual(&c->espera_produtor, &c->liberados, visto);
+            visto = __atomic_load_n(&c->liberados, __ATOMIC_ACQUIRE);
+        }
+        __atomic_store_n(&c->publicados, (int)(i + 1), __ATOMIC_RELEASE);
+        espera_acordar(&c->espera_consumidor, &c->publicados);
+    }
+}
+
+static long spsc_consumidor(void) {
+    long i, erros = 0;
+    int item;
+    for (i = 0; i < total_itens; i++) {
+        int visto = __atomic_load_n(&c->publicados, __ATOMIC_ACQUIRE);
+        while (!spsc_tentar_remover(&c->fila, &item)) {
+            espera_enquanto_igual(&c->espera_consumidor, &c->publicados, visto);
+            visto = __atomic_load_n(&c->publicados, __ATOMIC_ACQUIRE);
+        }
+        if (item != (int)i) erros++;
+        __atomic_store_n(&c->liberados, (int)(i + 1), __ATOMIC_RELEASE);
+        espera_acordar(&c->espera_produtor, &c->liberados);
+    }
+    return erros;
+}
+
+int tubo[2];
+// Extremidades de leitura e escrita do pipe (modo pipe).
+
+static void pipe_produtor(void) {
+    long i;
+    for (i = 0; i < total_itens; i++) {
+        int item = (int)i;
+        if (write(tubo[1], &item, sizeof(int)) != sizeof(int)) {
+            perror("write");
+            exit(1);
+        }
+    }
+}
+
+static long pipe_consumidor(void) {
+    long i, erros = 0;
+    int item;
+    for (i = 0; i < total_itens; i++) {
+        if (read(tubo[0], &item, sizeof(int)) != sizeof(int)) {
+            perror("read");
+            exit(1);
+        }
+        if (item != (int)i) erros++;
+    }
+    return erros;
+}
+
+/* ---- Execução ---- */
+
+typedef struct {
+    const char *nome;
+    void (*produtor)(void);
+    long (*consumidor)(void);
+} Modo;
+
+Modo modos[] = {
+    {"semaforo", semaforo_produtor, semaforo_consumidor},
+    {"spsc", spsc_produtor, spsc_consumidor},
+    {"pipe", pipe_produtor, pipe_consumidor},
+};
+
+#define N_MODOS (int)(sizeof(modos) / sizeof(modos[0]))
+
+static void iniciar_compartilhado(void) {
+    c->inicio = c->final = 0;
+    sem_init(&c->pos_vazia, 1, N_ITENS);
+    sem_init(&c->pos_ocupada, 1, 0);
+    // pshared = 1: semáforos usados por processos diferentes.
+
+    spsc_iniciar(&c->fila, c->buffer, N_ITENS);
+    c->publicados = c->liberados = 0;
+    espera_iniciar(&c->espera_produtor, giros, ESPERA_CESSOES_PADRAO, 1);
+    espera_iniciar(&c->espera_consumidor, giros, ESPERA_CESSOES_PADRAO, 1);
+    // compartilhado = 1: futex entre processos.
+}
+
+// Desfaz iniciar_compartilhado (a região mapeada é liberada uma única vez, em main)
+static void finalizar_compartilhado(void) {
+    sem_destroy(&c->pos_vazia);
+    sem_destroy(&c->pos_ocupada);
+}
+
+static double segundos_rusage(struct timeval t) {
+    return t.tv_sec + t.tv_usec / 1e6;
+}
+
+// Roda um modo e retorna 1 se o consumidor recebeu itens fora de ordem, ou -1 se não
+// foi possível criar o pipe ou o processo filho (o que iniciou já foi desfeito)
+static int medir_modo(Modo *m) {
+    struct rusage pai0, pai1, filhos0, filhos1;
+    struct timespec t0, t1;
+    double segundos, cpu;
+    long trocas_vol, trocas_inv;
+    pid_t pid;
+    int status;
+
+    iniciar_compartilhado();
+    if (pipe(tubo) != 0) {
+        perror("pipe");
+        finalizar_compartilhado();
+        return -1;
+    }
+
+    getrusage(RUSAGE_SELF, &pai0);
+    getrusage(RUSAGE_CHILDREN, &filhos0);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    fflush(stdout);
+    // Evita que o filho herde e repita a saída ainda no buffer.
+
+    pid = fork();
+    if (pid < 0) {
+        fprintf(stderr, "Fork falhou\n");
+        close(tubo[0]);
+        close(tubo[1]);
+        finalizar_compartilhado();
+        return -1;
+    } else if (pid == 0) {
+        // Filho: consumidor
+        close(tubo[1]);
+        _exit(m->consumidor() > 0);
+    }
+    // Pai: produtor
+    close(tubo[0]);
+    m->produtor();
+    close(tubo[1]);
+    waitpid(pid, &status, 0);
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    getrusage(RUSAGE_SELF, &pai1);
+    getrusage(RUSAGE_CHILDREN, &filhos1);
+    finalizar_compartilhado();
+
+    segundos = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    cpu = segundos_rusage(pai1.ru_utime) - segundos_rusage(pai0.ru_utime)
+        + segundos_rusage(pai1.ru_stime) - segundos_rusage(pai0.ru_stime)
+        + segundos_rusage(filhos1.ru_utime) - segundos_rusage(filhos0.ru_utime)
+        + segundos_rusage(filhos1.ru_stime) - segundos_rusage(filhos0.ru_stime);
+    trocas_vol = (pai1.ru_nvcsw - pai0.ru_nvcsw) + (filhos1.ru_nvcsw - filhos0.ru_nvcsw);
+    trocas_inv = (pai1.ru_nivcsw - pai0.ru_nivcsw) + (filhos1.ru_nivcsw - filhos0.ru_nivcsw);
+    printf("%-10s %12.0f %8.3f %11ld %11ld\n", m->nome, total_itens / segundos, cpu, trocas_vol, trocas_inv);
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("Erro: O consumidor de %s recebeu itens fora de ordem ou falhou.\n", m->nome);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    char *lista = NULL, *nome;
+    int opcao, i, resultado, escolhidos[N_MODOS] = {0}, algum_erro = 0;
+
+    while ((opcao = getopt(argc, argv, "n:m:")) != -1) {
+        switch (opcao) {
+        case 'n': total_itens = atol(optarg); break;
+        case 'm': lista = optarg; break;
+        default:
+            fprintf(stderr, "Uso: %s [-n itens] [-m modo,...]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (total_itens <= 0 || total_itens > INT_MAX) {
+        fprintf(stderr, "Erro: Use de 1 a %d itens.\n", INT_MAX);
+        return 1;
+    }
+    if (lista == NULL) {
+        for (i = 0; i < N_MODOS; i++) escolhidos[i] = 1;
+    } else {
+        for (nome = strtok(lista, ","); nome != NULL; nome = strtok(NULL, ",")) {
+            for (i = 0; i < N_MODOS && strcmp(modos[i].nome, nome) != 0; i++);
+            if (i == N_MODOS) {
+                fprintf(stderr, "Erro: Modo desconhecido: %s.\n", nome);
+                return 1;
+            }
+            escolhidos[i] = 1;
+        }
+    }
+
+    if (sysconf(_SC_NPROCESSORS_ONLN) == 1) {
+        giros = 0;
+    }
+    // Com um único processador, o outro processo não avança enquanto este gira: vai
+    // direto para sched_yield e para o futex.
+
+    c = (Compartilhado *)mmap(NULL, sizeof(Compartilhado), PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (c == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    // Memória compartilhada: depois do fork, pai e filho enxergam as mesmas páginas.
+
+    printf("%ld itens por modo, buffer de %d posições.\n", total_itens, N_ITENS);
+    printf("%-10s %12s %8s %11s %11s\n", "Modo", "Itens/s", "CPU (s)", "Trocas vol", "Trocas inv");
+    for (i = 0; i < N_MODOS; i++) {
+        if (!escolhidos[i]) continue;
+        resultado = medir_modo(&modos[i]);
+        if (resultado != 0) algum_erro = 1;
+        if (resultado < 0) break; // Sem pipe ou sem fork, os outros modos também falhariam
+    }
+
+    munmap(c, sizeof(Compartilhado));
+    return algum_erro;
+}
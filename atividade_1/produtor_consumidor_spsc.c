@@ -0,0 +1,166 @@
+/*
+ * Código para produtor e consumidor com uma fila circular sem travas (fila_spsc.h).
+ * Faz o mesmo que semaforo.c, mas sem semáforos: o produtor e o consumidor se
+ * sincronizam apenas por dois contadores atômicos (acquire/release) em linhas de cache
+ * separadas, então um item não custa nenhuma chamada ao sistema enquanto a fila não
+ * está cheia nem vazia.
+ *
+ * Compilação: gcc -O2 -pthread -o produtor_consumidor_spsc produtor_consumidor_spsc.c
+ * Uso: ./produtor_consumidor_spsc [itens [lote]]
+ *   Sem argumentos, produz e consome 3 * N_ITENS itens com pausas aleatórias, como
+ *   semaforo.c. Com `itens`, roda sem pausas nem impressão e mede a vazão, para
+ *   comparar com ./semaforo itens. Com `lote` > 1, o produtor reserva e publica até
+ *   `lote` posições por vez e o consumidor retira até `lote` itens por vez (uma única
+ *   sincronização por lote, ver fila_spsc.h).
+ */
+
+#include <pthread.h>  // Biblioteca para manipulação de threads.
+#include <stdio.h>    // Biblioteca padrão para entrada e saída.
+#include <stdlib.h>   // Biblioteca padrão para funções utilitárias.
+#include <unistd.h>   // Biblioteca para funções de tempo e chamadas ao sistema.
+#include <time.h>     // Para clock_gettime (modo de medição).
+#include "fila_spsc.h" // Fila circular sem travas para um produtor e um consumidor.
+
+#define N_ITENS 30
+// Define o tamanho do buffer circular como 30.
+
+int buffer[N_ITENS];
+// Declara o buffer circular que será compartilhado entre o produtor e o consumidor.
+
+FilaSpsc fila;
+// Contadores de itens produzidos e consumidos sobre `buffer` (em vez dos semáforos).
+
+long total_itens = 3 * N_ITENS;
+// Quantidade de itens produzidos e consumidos.
+
+int medir = 0;
+// 1 no modo de medição: sem pausas e sem impressão.
+
+long lote = 1;
+// Itens por sincronização no modo de medição (1: um item por vez).
+
+long erros = 0;
+// Itens recebidos fora de ordem (deve terminar em 0).
+
+static void produtor_lote(void) {
+    // Produtor em lotes: reserva posições contíguas, grava os itens e publica todos de uma vez.
+    long i = 0;
+    while (i < total_itens) {
+        int *posicoes;
+        uint64_t k = total_itens - i < lote ? (uint64_t)(total_itens - i) : (uint64_t)lote, j;
+        k = spsc_reservar(&fila, k, &posicoes);
+        if (k == 0) {
+            sched_yield();
+            continue;
+        }
+        // Fila cheia: cede o processador ao consumidor.
+
+        for (j = 0; j < k; j++) {
+            posicoes[j] = (int)(i + j);
+        }
+        spsc_publicar(&fila, k);
+        i += k;
+    }
+}
+
+static void consumidor_lote(void) {
+    // Consumidor em lotes: lê os itens prontos no próprio buffer e libera as posições de uma vez.
+    long i = 0;
+    while (i < total_itens) {
+        const int *itens;
+        uint64_t k = spsc_espiar(&fila, (uint64_t)lote, &itens), j;
+        if (k == 0) {
+            sched_yield();
+            continue;
+        }
+        // Fila vazia: cede o processador ao produtor.
+
+        for (j = 0; j < k; j++) {
+            if (itens[j] != (int)(i + j)) {
+                erros++;
+            }
+        }
+        spsc_liberar(&fila, k);
+        i += k;
+    }
+}
+
+void* produtor(void *v) {
+    // Função que será executada pela thread do produtor.
+    long i;
+    if (lote > 1) {
+        produtor_lote();
+        return NULL;
+    }
+    for (i = 0; i < total_itens; i++) {
+        spsc_inserir(&fila, (int)i);
+        // Espera haver espaço, grava o item e o publica para o consumidor.
+
+        if (!medir) {
+            printf("Produtor, item = %ld.\n", i);
+            sleep(random() % 3);
+            // Faz uma pausa aleatória (0 a 2 segundos) para simular o tempo de produção.
+        }
+    }
+    return NULL;
+}
+
+void* consumidor(void *v) {
+    // Função que será executada pela thread do consumidor.
+    long i;
+    if (lote > 1) {
+        consumidor_lote();
+        return NULL;
+    }
+    for (i = 0; i < total_itens; i++) {
+        int item = spsc_remover(&fila);
+        // Espera haver um item e libera a posição para o produtor.
+
+        if (item != (int)i) {
+            erros++;
+        }
+        // Na fila SPSC os itens chegam exatamente na ordem em que foram produzidos.
+
+        if (!medir) {
+            printf("Consumidor, item = %d.\n", item);
+            sleep(random() % 3);
+            // Faz uma pausa aleatória (0 a 2 segundos) para simular o tempo de consumo.
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    pthread_t thr_produtor, thr_consumidor;
+    struct timespec t0, t1;
+    double segundos;
+
+    if (argc > 1) {
+        total_itens = atol(argv[1]);
+        medir = 1;
+        if (argc > 2) lote = atol(argv[2]);
+        if (total_itens <= 0 || lote <= 0 || lote > N_ITENS) {
+            fprintf(stderr, "Uso: %s [itens [lote]] (lote de 1 a %d)\n", argv[0], N_ITENS);
+            return 1;
+        }
+    }
+
+    spsc_iniciar(&fila, buffer, N_ITENS);
+    // Fila vazia sobre o buffer de N_ITENS posições.
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    pthread_create(&thr_produtor, NULL, produtor, NULL);
+    pthread_create(&thr_consumidor, NULL, consumidor, NULL);
+    pthread_join(thr_produtor, NULL);
+    pthread_join(thr_consumidor, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    if (erros > 0) {
+        printf("Erro: %ld itens recebidos fora de ordem.\n", erros);
+    }
+    if (medir) {
+        segundos = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        printf("Fila SPSC (lote %ld): %ld itens em %.3f s (%.0f itens/s).\n", lote, total_itens, segundos, total_itens / segundos);
+    }
+    return erros > 0;
+}
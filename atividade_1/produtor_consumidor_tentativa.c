@@ -1,6 +1,12 @@
 /*
  * Código para produtor e consumidor com uma tentativa de
  * controle de concorrência baseada em espera ocupada.
+ *
+ * A espera pelo buffer (cheio para o produtor, vazio para o consumidor) é adaptativa
+ * (espera.h): gira por pouco tempo com a instrução de pausa da CPU, depois cede o
+ * processador e, se o outro lado continuar parado (por exemplo, durante o sleep),
+ * dorme em um futex até `cont` mudar, sem ocupar um núcleo.
+ * Uso: ./programa [-g giros] [-y cessoes] (0 giros e 0 cessões: dorme logo na primeira espera)
  */
 // Este comentário inicial explica que o código tenta implementar controle de concorrência
 // usando espera ocupada, o que não é eficiente.
@@ -9,6 +15,7 @@
 #include <stdio.h>    // Biblioteca padrão para entrada e saída.
 #include <stdlib.h>   // Biblioteca padrão para funções utilitárias.
 #include <unistd.h>   // Biblioteca para funções de tempo e chamadas ao sistema.
+#include "espera.h"   // Espera adaptativa: giro, cessão do processador e futex.
 
 #define N_ITENS 10
 // Define o tamanho do buffer circular como 10.
@@ -20,13 +27,16 @@ int inicio = 0, final = 0, cont = 0;
 // `inicio` e `final` controlam as posições no buffer circular.
 // `cont` mantém o número de itens atualmente no buffer.
 
+EsperaAdaptativa espera;
+// Estado da espera adaptativa pelas mudanças de `cont` (orçamentos de giro e de cessão).
+
 void* produtor(void *v) {
     // Função que será executada pela thread do produtor.
     int i;
     for (i = 0; i < 3 * N_ITENS; i++) {
         // Produz 3 vezes o número de itens do buffer.
-        while (cont == N_ITENS);
-        // Espera ocupada: aguarda até que haja espaço no buffer.
+        espera_enquanto_igual(&espera, &cont, N_ITENS);
+        // Aguarda até que haja espaço no buffer: gira, cede o processador e por fim dorme.
 
         printf("Produtor, item = %d.\n", i);
         // Imprime o item que está sendo produzido.
@@ -40,6 +50,9 @@ void* produtor(void *v) {
         cont++;
         // Incrementa o contador de itens no buffer.
 
+        espera_acordar(&espera, &cont);
+        // Acorda o consumidor, se ele estiver dormindo à espera de um item.
+
         sleep(random() % 3);
         // Faz uma pausa aleatória (0 a 2 segundos) para simular o tempo de produção.
     }
@@ -52,8 +65,8 @@ void* consumidor(void *v) {
     int i, aux;
     for (i = 0; i < 3 * N_ITENS; i++) {
         // Consome 3 vezes o número de itens do buffer.
-        while (cont == 0);
-        // Espera ocupada: aguarda até que haja itens no buffer.
+        espera_enquanto_igual(&espera, &cont, 0);
+        // Aguarda até que haja itens no buffer: gira, cede o processador e por fim dorme.
 
         inicio = (inicio + 1) % N_ITENS;
         // Atualiza a posição inicial no buffer circular.
@@ -75,6 +88,9 @@ void* consumidor(void *v) {
         cont--;
         // Decrementa o contador de itens no buffer.
 
+        espera_acordar(&espera, &cont);
+        // Acorda o produtor, se ele estiver dormindo à espera de espaço.
+
         sleep(random() % 3);
         // Faz uma pausa aleatória (0 a 2 segundos) para simular o tempo de consumo.
     }
@@ -82,12 +98,26 @@ void* consumidor(void *v) {
     // Retorna NULL ao final da execução.
 }
 
-int main() {
+int main(int argc, char *argv[]) {
     // Função principal do programa.
-    int i;
+    int i, opcao;
+    int giros = ESPERA_GIROS_PADRAO, cessoes = ESPERA_CESSOES_PADRAO;
+    // Orçamentos da espera adaptativa (opções -g e -y).
     pthread_t thr_produtor, thr_consumidor;
     // Declara duas variáveis para armazenar os identificadores das threads.
 
+    while ((opcao = getopt(argc, argv, "g:y:")) != -1) {
+        switch (opcao) {
+        case 'g': giros = atoi(optarg); break;
+        case 'y': cessoes = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Uso: %s [-g giros] [-y cessoes]\n", argv[0]);
+            return 1;
+        }
+    }
+    espera_iniciar(&espera, giros, cessoes, 0);
+    // Espera entre threads do mesmo processo (futex privado).
+
     /* Limpa o buffer */
     for (i = 0; i < N_ITENS; i++)
         buffer[i] = 0;
@@ -105,6 +135,9 @@ int main() {
     pthread_join(thr_consumidor, NULL);
     // Aguarda a conclusão da thread do consumidor.
 
+    printf("Esperas que terminaram dormindo no futex: %ld.\n", (long)espera.dormidas);
+    // Quantas vezes um dos lados parou de girar e dormiu até `cont` mudar.
+
     return 0;
     // Retorna 0 indicando que o programa foi executado com sucesso.
 }
@@ -6,6 +6,7 @@
 #include <stdlib.h>   // Biblioteca padrão para funções utilitárias.
 #include <unistd.h>   // Biblioteca para funções de tempo e chamadas ao sistema.
 #include <semaphore.h> // Biblioteca para manipulação de semáforos.
+#include <time.h>     // Para clock_gettime (modo de medição).
 
 #define N_ITENS 30
 // Define o tamanho do buffer circular como 30.
@@ -22,28 +23,35 @@ sem_t pos_ocupada;
 int inicio = 0, final = 0;
 // `inicio` e `final` controlam as posições no buffer circular.
 
+long total_itens = 3 * N_ITENS;
+// Quantidade de itens produzidos e consumidos (3 vezes o número de itens do buffer).
+
+int medir = 0;
+// 1 no modo de medição (./semaforo itens): sem pausas e sem impressão, para comparar
+// a vazão com a fila sem travas de produtor_consumidor_spsc.c.
+
 void* produtor(void *v) {
     // Função que será executada pela thread do produtor.
-    int i;
-    for (i = 0; i < 3 * N_ITENS; i++) {
-        // Produz 3 vezes o número de itens do buffer.
+    long i;
+    for (i = 0; i < total_itens; i++) {
+        // Produz `total_itens` itens.
 
         sem_wait(&pos_vazia);
         // Decrementa o semáforo `pos_vazia`. Aguarda até que haja espaço no buffer.
 
-        printf("Produtor, item = %d.\n", i);
+        if (!medir) printf("Produtor, item = %ld.\n", i);
         // Imprime o item que está sendo produzido.
 
         final = (final + 1) % N_ITENS;
         // Atualiza a posição final no buffer circular.
 
-        buffer[final] = i;
+        buffer[final] = (int)i;
         // Armazena o item produzido no buffer.
 
         sem_post(&pos_ocupada);
         // Incrementa o semáforo `pos_ocupada`, indicando que há um novo item no buffer.
 
-        sleep(random() % 3);
+        if (!medir) sleep(random() % 3);
         // Faz uma pausa aleatória (0 a 2 segundos) para simular o tempo de produção.
     }
     return NULL;
@@ -52,9 +60,9 @@ void* produtor(void *v) {
 
 void* consumidor(void *v) {
     // Função que será executada pela thread do consumidor.
-    int i;
-    for (i = 0; i < 3 * N_ITENS; i++) {
-        // Consome 3 vezes o número de itens do buffer.
+    long i;
+    for (i = 0; i < total_itens; i++) {
+        // Consome `total_itens` itens.
 
         sem_wait(&pos_ocupada);
         // Decrementa o semáforo `pos_ocupada`. Aguarda até que haja itens no buffer.
@@ -62,30 +70,46 @@ void* consumidor(void *v) {
         inicio = (inicio + 1) % N_ITENS;
         // Atualiza a posição inicial no buffer circular.
 
-        printf("Consumidor, item = %d.\n", buffer[inicio]);
+        if (!medir) printf("Consumidor, item = %d.\n", buffer[inicio]);
         // Imprime o item que está sendo consumido.
 
         sem_post(&pos_vazia);
         // Incrementa o semáforo `pos_vazia`, indicando que há uma nova posição vazia no buffer.
 
-        sleep(random() % 3);
+        if (!medir) sleep(random() % 3);
         // Faz uma pausa aleatória (0 a 2 segundos) para simular o tempo de consumo.
     }
     return NULL;
     // Retorna NULL ao final da execução.
 }
 
-int main() {
+int main(int argc, char *argv[]) {
     // Função principal do programa.
     pthread_t thr_produtor, thr_consumidor;
     // Declara duas variáveis para armazenar os identificadores das threads.
 
+    struct timespec t0, t1;
+    // Instantes de início e fim (modo de medição).
+
+    if (argc > 1) {
+        total_itens = atol(argv[1]);
+        medir = 1;
+        if (total_itens <= 0) {
+            fprintf(stderr, "Uso: %s [itens]\n", argv[0]);
+            return 1;
+        }
+    }
+    // Com um argumento, roda `itens` itens sem pausas e mede a vazão.
+
     sem_init(&pos_vazia, 0, N_ITENS);
     // Inicializa o semáforo `pos_vazia` com o valor `N_ITENS` (todas as posições estão inicialmente vazias).
 
     sem_init(&pos_ocupada, 0, 0);
     // Inicializa o semáforo `pos_ocupada` com o valor 0 (nenhuma posição está ocupada inicialmente).
 
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    // Marca o início da medição.
+
     pthread_create(&thr_produtor, NULL, produtor, NULL);
     // Cria a thread do produtor e a associa à função `produtor`.
 
@@ -98,6 +122,13 @@ int main() {
     pthread_join(thr_consumidor, NULL);
     // Aguarda a conclusão da thread do consumidor.
 
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (medir) {
+        double segundos = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        printf("Semáforos: %ld itens em %.3f s (%.0f itens/s).\n", total_itens, segundos, total_itens / segundos);
+    }
+    // Exibe a vazão no modo de medição.
+
     sem_destroy(&pos_vazia);
     // Destroi o semáforo `pos_vazia`.
 
@@ -0,0 +1,302 @@
+/*
+ * Árvore rubro-negra indexada de índices de processos.
+ * Assim como o heap indexado (heap.h), cada nó é o índice de um processo no vetor do
+ * simulador e a ordem é dada por uma função de comparação fornecida pelo usuário (no
+ * escalonador justo, vruntime -> ID). Os ponteiros da árvore ficam em vetores paralelos
+ * indexados pelo processo, então não há alocação por inserção. O nó mais à esquerda
+ * (o menor) é mantido em cache.
+ *
+ * Operações:
+ * - arvore_inserir, arvore_remover: O(log n)
+ * - arvore_minimo, arvore_vazia, arvore_contem: O(1)
+ *
+ * Uso: basta incluir este arquivo; as funções são `static inline`.
+ */
+
+#ifndef ARVORE_RB_H
+#define ARVORE_RB_H
+
+#include <stdlib.h> // Para malloc, free
+
+#define RB_VERMELHO 0
+#define RB_PRETO 1
+#define RB_AUSENTE 2 // Cor dos índices que não estão na árvore
+
+// Compara os processos de índices a e b. Retorna < 0 se a vem antes de b, > 0 se b
+// vem antes de a e 0 se forem equivalentes (o que não deve ocorrer entre nós distintos).
+typedef int (*ArvoreComparador)(int a, int b, const void *contexto);
+
+typedef struct {
+    int *esquerda, *direita, *pai; // Ligações de cada nó; `nulo` faz o papel de folha
+    unsigned char *cor;            // RB_VERMELHO, RB_PRETO ou RB_AUSENTE
+    int raiz;
+    int nulo;                      // Sentinela (índice = capacidade), sempre preta
+    int minimo;                    // Nó mais à esquerda, ou -1 se vazia
+    int tamanho;
+    ArvoreComparador comparar;
+    const void *contexto;          // Repassado ao comparador (normalmente o vetor de processos)
+} ArvoreRB;
+
+// Aloca uma árvore capaz de conter os índices 0..capacidade-1. Retorna 0 em caso de
+// sucesso e -1 se a alocação falhar.
+static inline int arvore_criar(ArvoreRB *a, int capacidade, ArvoreComparador comparar, const void *contexto) {
+    size_t total = (size_t)capacidade + 1; // +1 para a sentinela
+    int i;
+    a->esquerda = (int *)malloc(total * sizeof(int));
+    a->direita = (int *)malloc(total * sizeof(int));
+    a->pai = (int *)malloc(total * sizeof(int));
+    a->cor = (unsigned char *)malloc(total);
+    if (a->esquerda == NULL || a->direita == NULL || a->pai == NULL || a->cor == NULL) {
+        free(a->esquerda);
+        free(a->direita);
+        free(a->pai);
+        free(a->cor);
+        a->esquerda = a->direita = a->pai = NULL;
+        a->cor = NULL;
+        return -1;
+    }
+    for (i = 0; i < capacidade; i++) {
+        a->cor[i] = RB_AUSENTE;
+    }
+    a->nulo = capacidade;
+    a->cor[a->nulo] = RB_PRETO;
+    a->esquerda[a->nulo] = a->direita[a->nulo] = a->pai[a->nulo] = a->nulo;
+    a->raiz = a->nulo;
+    a->minimo = -1;
+    a->tamanho = 0;
+    a->comparar = comparar;
+    a->contexto = contexto;
+    return 0;
+}
+
+static inline void arvore_destruir(ArvoreRB *a) {
+    free(a->esquerda);
+    free(a->direita);
+    free(a->pai);
+    free(a->cor);
+    a->esquerda = a->direita = a->pai = NULL;
+    a->cor = NULL;
+    a->tamanho = 0;
+}
+
+static inline int arvore_vazia(const ArvoreRB *a) {
+    return a->tamanho == 0;
+}
+
+// Índice do menor processo da árvore, ou -1 se vazia
+static inline int arvore_minimo(const ArvoreRB *a) {
+    return a->minimo;
+}
+
+static inline int arvore_contem(const ArvoreRB *a, int idx) {
+    return a->cor[idx] != RB_AUSENTE;
+}
+
+// Menor nó da subárvore com raiz x
+static inline int arvore_primeiro(const ArvoreRB *a, int x) {
+    while (a->esquerda[x] != a->nulo) x = a->esquerda[x];
+    return x;
+}
+
+static inline void arvore_girar_esquerda(ArvoreRB *a, int x) {
+    int y = a->direita[x];
+    a->direita[x] = a->esquerda[y];
+    if (a->esquerda[y] != a->nulo) a->pai[a->esquerda[y]] = x;
+    a->pai[y] = a->pai[x];
+    if (a->pai[x] == a->nulo) a->raiz = y;
+    else if (x == a->esquerda[a->pai[x]]) a->esquerda[a->pai[x]] = y;
+    else a->direita[a->pai[x]] = y;
+    a->esquerda[y] = x;
+    a->pai[x] = y;
+}
+
+static inline void arvore_girar_direita(ArvoreRB *a, int x) {
+    int y = a->esquerda[x];
+    a->esquerda[x] = a->direita[y];
+    if (a->direita[y] != a->nulo) a->pai[a->direita[y]] = x;
+    a->pai[y] = a->pai[x];
+    if (a->pai[x] == a->nulo) a->raiz = y;
+    else if (x == a->direita[a->pai[x]]) a->direita[a->pai[x]] = y;
+    else a->esquerda[a->pai[x]] = y;
+    a->direita[y] = x;
+    a->pai[x] = y;
+}
+
+// Insere o processo idx (que não pode já estar na árvore)
+static inline void arvore_inserir(ArvoreRB *a, int idx) {
+    int y = a->nulo, x = a->raiz, mais_a_esquerda = 1;
+
+    // Descida de busca comum
+    while (x != a->nulo) {
+        y = x;
+        if (a->comparar(idx, x, a->contexto) < 0) {
+            x = a->esquerda[x];
+        } else {
+            x = a->direita[x];
+            mais_a_esquerda = 0;
+        }
+    }
+    a->pai[idx] = y;
+    if (y == a->nulo) a->raiz = idx;
+    else if (a->comparar(idx, y, a->contexto) < 0) a->esquerda[y] = idx;
+    else a->direita[y] = idx;
+    a->esquerda[idx] = a->direita[idx] = a->nulo;
+    a->cor[idx] = RB_VERMELHO;
+    a->tamanho++;
+    if (mais_a_esquerda) a->minimo = idx;
+
+    // Corrige violações de "vermelho com pai vermelho" subindo pela árvore
+    while (a->cor[a->pai[idx]] == RB_VERMELHO) {
+        int pai = a->pai[idx], avo = a->pai[pai];
+        if (pai == a->esquerda[avo]) {
+            int tio = a->direita[avo];
+            if (a->cor[tio] == RB_VERMELHO) {
+                a->cor[pai] = a->cor[tio] = RB_PRETO;
+                a->cor[avo] = RB_VERMELHO;
+                idx = avo;
+            } else {
+                if (idx == a->direita[pai]) {
+                    idx = pai;
+                    arvore_girar_esquerda(a, idx);
+                    pai = a->pai[idx];
+                }
+                a->cor[pai] = RB_PRETO;
+                a->cor[avo] = RB_VERMELHO;
+                arvore_girar_direita(a, avo);
+            }
+        } else {
+            int tio = a->esquerda[avo];
+            if (a->cor[tio] == RB_VERMELHO) {
+                a->cor[pai] = a->cor[tio] = RB_PRETO;
+                a->cor[avo] = RB_VERMELHO;
+                idx = avo;
+            } else {
+                if (idx == a->esquerda[pai]) {
+                    idx = pai;
+                    arvore_girar_direita(a, idx);
+                    pai = a->pai[idx];
+                }
+                a->cor[pai] = RB_PRETO;
+                a->cor[avo] = RB_VERMELHO;
+                arvore_girar_esquerda(a, avo);
+            }
+        }
+    }
+    a->cor[a->raiz] = RB_PRETO;
+}
+
+// Coloca a subárvore v no lugar da subárvore u
+static inline void arvore_transplantar(ArvoreRB *a, int u, int v) {
+    if (a->pai[u] == a->nulo) a->raiz = v;
+    else if (u == a->esquerda[a->pai[u]]) a->esquerda[a->pai[u]] = v;
+    else a->direita[a->pai[u]] = v;
+    a->pai[v] = a->pai[u];
+}
+
+// Remove o processo idx, esteja ele em qualquer posição da árvore
+static inline void arvore_remover(ArvoreRB *a, int idx) {
+    int x, y = idx;
+    unsigned char cor_removida = a->cor[y];
+
+    if (a->cor[idx] == RB_AUSENTE) return;
+
+    // O sucessor do mínimo é o menor nó da subárvore direita ou, na falta dela, o pai
+    if (idx == a->minimo) {
+        a->minimo = a->direita[idx] != a->nulo ? arvore_primeiro(a, a->direita[idx]) : a->pai[idx];
+        if (a->minimo == a->nulo) a->minimo = -1;
+    }
+
+    if (a->esquerda[idx] == a->nulo) {
+        x = a->direita[idx];
+        arvore_transplantar(a, idx, x);
+    } else if (a->direita[idx] == a->nulo) {
+        x = a->esquerda[idx];
+        arvore_transplantar(a, idx, x);
+    } else {
+        y = arvore_primeiro(a, a->direita[idx]);
+        cor_removida = a->cor[y];
+        x = a->direita[y];
+        if (a->pai[y] == idx) {
+            a->pai[x] = y; // x pode ser a sentinela; a correção abaixo precisa do pai
+        } else {
+            arvore_transplantar(a, y, x);
+            a->direita[y] = a->direita[idx];
+            a->pai[a->direita[y]] = y;
+        }
+        arvore_transplantar(a, idx, y);
+        a->esquerda[y] = a->esquerda[idx];
+        a->pai[a->esquerda[y]] = y;
+        a->cor[y] = a->cor[idx];
+    }
+    a->cor[idx] = RB_AUSENTE;
+    a->tamanho--;
+
+    // Remover um nó preto deixa um caminho com um preto a menos: redistribui as cores
+    if (cor_removida == RB_PRETO) {
+        while (x != a->raiz && a->cor[x] == RB_PRETO) {
+            int pai = a->pai[x];
+            if (x == a->esquerda[pai]) {
+                int w = a->direita[pai];
+                if (a->cor[w] == RB_VERMELHO) {
+                    a->cor[w] = RB_PRETO;
+                    a->cor[pai] = RB_VERMELHO;
+                    arvore_girar_esquerda(a, pai);
+                    w = a->direita[pai];
+                }
+                if (a->cor[a->esquerda[w]] == RB_PRETO && a->cor[a->direita[w]] == RB_PRETO) {
+                    a->cor[w] = RB_VERMELHO;
+                    x = pai;
+                } else {
+                    if (a->cor[a->direita[w]] == RB_PRETO) {
+                        a->cor[a->esquerda[w]] = RB_PRETO;
+                        a->cor[w] = RB_VERMELHO;
+                        arvore_girar_direita(a, w);
+                        w = a->direita[pai];
+                    }
+                    a->cor[w] = a->cor[pai];
+                    a->cor[pai] = RB_PRETO;
+                    a->cor[a->direita[w]] = RB_PRETO;
+                    arvore_girar_esquerda(a, pai);
+                    x = a->raiz;
+                }
+            } else {
+                int w = a->esquerda[pai];
+                if (a->cor[w] == RB_VERMELHO) {
+                    a->cor[w] = RB_PRETO;
+                    a->cor[pai] = RB_VERMELHO;
+                    arvore_girar_direita(a, pai);
+                    w = a->esquerda[pai];
+                }
+                if (a->cor[a->direita[w]] == RB_PRETO && a->cor[a->esquerda[w]] == RB_PRETO) {
+                    a->cor[w] = RB_VERMELHO;
+                    x = pai;
+                } else {
+                    if (a->cor[a->esquerda[w]] == RB_PRETO) {
+                        a->cor[a->direita[w]] = RB_PRETO;
+                        a->cor[w] = RB_VERMELHO;
+                        arvore_girar_esquerda(a, w);
+                        w = a->esquerda[pai];
+                    }
+                    a->cor[w] = a->cor[pai];
+                    a->cor[pai] = RB_PRETO;
+                    a->cor[a->esquerda[w]] = RB_PRETO;
+                    arvore_girar_direita(a, pai);
+                    x = a->raiz;
+                }
+            }
+        }
+        a->cor[x] = RB_PRETO;
+    }
+    a->cor[a->nulo] = RB_PRETO;
+}
+
+// Remove e retorna o menor processo, ou -1 se a árvore estiver vazia
+static inline int arvore_remover_minimo(ArvoreRB *a) {
+    int minimo = a->minimo;
+    if (minimo != -1) {
+        arvore_remover(a, minimo);
+    }
+    return minimo;
+}
+
+#endif // ARVORE_RB_H
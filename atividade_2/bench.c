@@ -0,0 +1,217 @@
+/*
+ * Bancada de Desempenho dos Escalonadores
+ * Este programa mede quanto custa simular cada política (FCFS, SJF, SRTF, Round Robin
+ * e Prioridade) à medida que a carga cresce. Para cada tamanho 10^k, com k na faixa
+ * pedida, uma carga sintética é gerada em memória (ver gerador.h, sempre com a mesma
+ * semente) e simulada pelo motor; de cada política é tomado o menor tempo entre as
+ * repetições. São exibidos o tempo total, o custo por decisão de escalonamento
+ * (nanossegundos por vez em que um processo foi escolhido para a CPU) e o pico de
+ * memória residente de cada medida. Cada política é simulada em um processo filho
+ * (fork), e o pico vem do ru_maxrss desse filho (wait4): é o da carga com os resultados
+ * daquela política, e não o maior pico do programa até então.
+ *
+ * Comparar a saída (de preferência em CSV) entre versões do código permite perceber
+ * regressões de desempenho nos escalonadores.
+ *
+ * Compilação: gcc -O2 -pthread -o bench bench.c motor.c -lm
+ * Uso: ./bench [-n inicio:fim] [-r repeticoes] [-q quantum] [-f tabela|csv] [-s semente]
+ *              [-u utilizacao] [-d exponencial|pareto|lognormal] [-p uniforme|geometrica|fixa]
+ *   -n: expoentes dos tamanhos, de 10^inicio a 10^fim processos (padrão: 3:6, máximo 8)
+ *   -r: repetições de cada medida; vale a menor (padrão: 3)
+ *   -q: quantum do Round Robin (padrão: 4)
+ *   -f: formato da saída (padrão: tabela)
+ *   -s, -u, -d, -p: parâmetros da carga gerada (ver gerador.c)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>       // Para atoi, atof, strtoull
+#include <string.h>       // Para strcmp
+#include <unistd.h>       // Para getopt, fork, pipe, read, write
+#include <sys/wait.h>     // Para wait4
+#include <sys/resource.h> // Para struct rusage
+#include "motor.h"
+#include "gerador.h"      // Cargas sintéticas reprodutíveis
+
+#define N_POLITICAS 5
+#define EXPOENTE_MAXIMO 8
+
+// Resultado de uma política em um tamanho de carga, enviado pelo filho ao pai
+typedef struct {
+    int status;             // 0 ou 1 se a simulação falhou (mensagem em stderr)
+    double melhor;          // Menor tempo entre as repetições, em segundos
+    long decisoes;
+    long trocas_contexto;
+    double pico_mib;        // Pico de memória residente do filho (preenchido pelo pai)
+} Medida;
+
+// Simula a política `repeticoes` vezes em um processo filho e preenche *m.
+// Retorna 0 ou -1 se o filho não pôde ser criado ou não entregou a medida.
+static int medir_em_filho(const CargaTrabalho *carga, const Politica *politica, int quantum,
+                          int repeticoes, Medida *m) {
+    struct rusage uso;
+    int tubo[2], estado, r;
+    ssize_t lidos;
+    pid_t pid;
+
+    if (pipe(tubo) != 0) return -1;
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0) {
+        close(tubo[0]);
+        close(tubo[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        Resultado res;
+        close(tubo[0]);
+        memset(m, 0, sizeof(*m));
+        if (motor_preparar_resultado(&res, carga, politica, quantum) != 0) {
+            fprintf(stderr, "Erro: Falha na alocação de memória para os resultados!\n");
+            m->status = 1;
+        } else {
+            for (r = 0; r < repeticoes; r++) {
+                if (motor_executar(carga, &res) != 0) {
+                    fprintf(stderr, "Erro: Falha de memória na simulação de %s.\n", politica->nome);
+                    m->status = 1;
+                    break;
+                }
+                if (r == 0 || res.segundos < m->melhor) m->melhor = res.segundos;
+            }
+            m->decisoes = res.decisoes;
+            m->trocas_contexto = res.trocas_contexto;
+            motor_liberar_resultado(&res);
+        }
+        _exit(write(tubo[1], m, sizeof(*m)) == (ssize_t)sizeof(*m) ? 0 : 1);
+    }
+
+    close(tubo[1]);
+    lidos = read(tubo[0], m, sizeof(*m));
+    close(tubo[0]);
+    if (wait4(pid, &estado, 0, &uso) < 0 || lidos != (ssize_t)sizeof(*m)) return -1;
+    m->pico_mib = uso.ru_maxrss / 1024.0; // ru_maxrss é dado em KiB no Linux
+    return 0;
+}
+
+// Gera a carga com n processos. Retorna 0 ou -1 em caso de erro.
+static int gerar_carga(CargaTrabalho *carga, int n, const ParametrosGerador *parametros) {
+    GeradorCarga gerador;
+
+    if (gerador_iniciar(&gerador, parametros) != 0) return -1;
+    if (motor_alocar_carga(carga, n) != 0) return -1;
+    if (gerador_gerar(&gerador, n, carga->chegada, carga->duracao, carga->prioridade) != 0) {
+        motor_liberar_carga(carga);
+        return -1;
+    }
+    if (motor_indexar_chegadas(carga) != 0) {
+        motor_liberar_carga(carga);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const Politica *politicas[N_POLITICAS] = {&politica_fcfs, &politica_sjf, &politica_srtf, &politica_rr, &politica_prioridade};
+    ParametrosGerador parametros;
+    int expoente_inicio = 3, expoente_fim = 6, repeticoes = 3, quantum = 4, csv = 0;
+    int opcao, expoente, k, status = 0;
+
+    gerador_parametros_padrao(&parametros);
+    while ((opcao = getopt(argc, argv, "n:r:q:f:s:u:d:p:")) != -1) {
+        switch (opcao) {
+        case 'n':
+            if (sscanf(optarg, "%d:%d", &expoente_inicio, &expoente_fim) < 2) {
+                expoente_fim = expoente_inicio;
+            }
+            break;
+        case 'r': repeticoes = atoi(optarg); break;
+        case 'q': quantum = atoi(optarg); break;
+        case 'f':
+            if (strcmp(optarg, "csv") == 0) csv = 1;
+            else if (strcmp(optarg, "tabela") == 0) csv = 0;
+            else {
+                fprintf(stderr, "Erro: Formato '%s' desconhecido (use tabela ou csv).\n", optarg);
+                return 1;
+            }
+            break;
+        case 's': parametros.semente = strtoull(optarg, NULL, 10); break;
+        case 'u': parametros.utilizacao = atof(optarg); break;
+        case 'd':
+            if (gerador_distribuicao_duracao(optarg, &parametros.duracao) != 0) {
+                fprintf(stderr, "Erro: Distribuição '%s' desconhecida (use exponencial, pareto ou lognormal).\n", optarg);
+                return 1;
+            }
+            break;
+        case 'p':
+            if (gerador_distribuicao_prioridade(optarg, &parametros.prioridade) != 0) {
+                fprintf(stderr, "Erro: Distribuição '%s' desconhecida (use uniforme, geometrica ou fixa).\n", optarg);
+                return 1;
+            }
+            break;
+        default:
+            fprintf(stderr, "Uso: %s [-n inicio:fim] [-r repeticoes] [-q quantum] [-f tabela|csv] [-s semente]\n"
+                            "       [-u utilizacao] [-d exponencial|pareto|lognormal] [-p uniforme|geometrica|fixa]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (expoente_inicio < 1 || expoente_fim < expoente_inicio || expoente_fim > EXPOENTE_MAXIMO) {
+        fprintf(stderr, "Erro: Os expoentes de -n devem satisfazer 1 <= inicio <= fim <= %d.\n", EXPOENTE_MAXIMO);
+        return 1;
+    }
+    if (repeticoes <= 0 || quantum <= 0) {
+        fprintf(stderr, "Erro: Repetições e quantum devem ser inteiros positivos.\n");
+        return 1;
+    }
+
+    if (csv) {
+        printf("processos,politica,segundos,decisoes,ns_por_decisao,trocas_contexto,pico_memoria_mib\n");
+    } else {
+        printf("Bancada de Desempenho dos Escalonadores\n");
+        printf("---------------------------------------\n");
+        printf("Semente %llu, utilização %.2f, quantum %d, melhor de %d repetições\n\n",
+               (unsigned long long)parametros.semente, parametros.utilizacao, quantum, repeticoes);
+        printf("+------------+--------------+--------------+--------------+----------------+-----------------+\n");
+        printf("| %-10s | %-12s | %-12s | %-12s | %-14s | %-15s |\n",
+               "Processos", "Política", "Tempo (ms)", "Decisões", "ns por decisão", "Pico RSS (MiB)");
+        printf("+------------+--------------+--------------+--------------+----------------+-----------------+\n");
+    }
+
+    for (expoente = expoente_inicio; expoente <= expoente_fim && status == 0; expoente++) {
+        CargaTrabalho carga;
+        int n = 1;
+        for (k = 0; k < expoente; k++) n *= 10;
+
+        if (gerar_carga(&carga, n, &parametros) != 0) {
+            status = 1;
+            break;
+        }
+        for (k = 0; k < N_POLITICAS; k++) {
+            Medida m;
+            double ns;
+
+            if (medir_em_filho(&carga, politicas[k], quantum, repeticoes, &m) != 0) {
+                fprintf(stderr, "Erro: Falha ao medir %s em um processo filho.\n", politicas[k]->nome);
+                status = 1;
+                break;
+            }
+            if (m.status != 0) {
+                status = 1;
+                break;
+            }
+            ns = m.decisoes > 0 ? m.melhor * 1e9 / m.decisoes : 0;
+            if (csv) {
+                printf("%d,%s,%.6f,%ld,%.2f,%ld,%.1f\n", n, politicas[k]->nome, m.melhor,
+                       m.decisoes, ns, m.trocas_contexto, m.pico_mib);
+            } else {
+                printf("| %10d | %-12s | %12.2f | %12ld | %14.2f | %15.1f |\n", n, politicas[k]->nome,
+                       m.melhor * 1e3, m.decisoes, ns, m.pico_mib);
+            }
+            fflush(stdout);
+        }
+        motor_liberar_carga(&carga);
+    }
+
+    if (!csv) {
+        printf("+------------+--------------+--------------+--------------+----------------+-----------------+\n");
+    }
+    return status;
+}
@@ -0,0 +1,230 @@
+/*
+ * Leitura não interativa de cargas de trabalho (listas de processos) a partir de arquivo.
+ * O arquivo é mapeado em memória com mmap e percorrido uma única vez, registro a registro,
+ * preenchendo diretamente o vetor de processos do simulador.
+ *
+ * Formatos aceitos (detectados automaticamente pelo conteúdo):
+ * - CSV: uma linha por processo no formato "chegada,duracao[,prioridade]".
+ *   Linhas em branco, linhas iniciadas por '#' e um cabeçalho textual (a primeira linha
+ *   não vazia, se não tiver dígitos) são ignorados; qualquer outra linha malformada é erro.
+ *   A prioridade é opcional (padrão 0) para os algoritmos que não a utilizam.
+ * - Binário: cabeçalho CargaCabecalho ("ESCB", versão, quantidade) seguido de
+ *   `quantidade` registros CargaRegistro de tamanho fixo (três int32 em ordem nativa).
+ *
+ * Uso típico:
+ *     LeitorCarga carga;
+ *     if (carga_abrir(&carga, caminho) != 0) ...;
+ *     n = carga_quantidade(&carga);
+ *     for (i = 0; i < n; i++) carga_proximo(&carga, &chegada, &duracao, &prioridade);
+ *     carga_fechar(&carga);
+ */
+
+#ifndef CARGA_H
+#define CARGA_H
+
+#include <stdio.h>     // Para fprintf
+#include <stdint.h>    // Para int32_t, uint32_t, uint64_t
+#include <string.h>    // Para memcmp, memchr
+#include <limits.h>    // Para INT_MAX
+#include <fcntl.h>     // Para open
+#include <unistd.h>    // Para close, sysconf
+#include <sys/mman.h>  // Para mmap, munmap, madvise
+#include <sys/stat.h>  // Para fstat
+
+#define CARGA_MAGICO "ESCB"
+#define CARGA_VERSAO 1
+
+// Cabeçalho do formato binário
+typedef struct {
+    char magico[4];       // Sempre "ESCB"
+    uint32_t versao;      // CARGA_VERSAO
+    uint64_t quantidade;  // Número de registros que seguem o cabeçalho
+} CargaCabecalho;
+
+// Registro de tamanho fixo do formato binário (um por processo)
+typedef struct {
+    int32_t chegada;
+    int32_t duracao;
+    int32_t prioridade;
+} CargaRegistro;
+
+typedef struct {
+    const char *caminho;   // Nome do arquivo (para mensagens de erro)
+    const char *dados;     // Início do arquivo mapeado em memória
+    size_t tamanho;        // Tamanho do arquivo em bytes
+    const char *cursor;    // Próximo byte a ser lido (CSV) ou próximo registro (binário)
+    int binario;           // 1 se o arquivo está no formato binário, 0 se CSV
+    long quantidade;       // Número total de processos no arquivo
+    long lidos;            // Processos já entregues por carga_proximo
+    long linha;            // Linha atual do CSV (para mensagens de erro)
+    int antes_do_primeiro; // 1 até a primeira linha não vazia do CSV (possível cabeçalho)
+} LeitorCarga;
+
+// Ignora espaços e tabulações a partir de *cur
+static inline void carga_pular_espacos(const char **cur, const char *fim) {
+    while (*cur < fim && (**cur == ' ' || **cur == '\t' || **cur == '\r')) (*cur)++;
+}
+
+// Lê um inteiro decimal não negativo. Retorna 0 em caso de sucesso e -1 se não houver
+// dígitos ou se o valor não couber em um int.
+static inline int carga_ler_inteiro(const char **cur, const char *fim, int *valor) {
+    long long v = 0;
+    const char *inicio;
+    carga_pular_espacos(cur, fim);
+    inicio = *cur;
+    while (*cur < fim && **cur >= '0' && **cur <= '9') {
+        v = v * 10 + (**cur - '0');
+        if (v > INT_MAX) return -1;
+        (*cur)++;
+    }
+    if (*cur == inicio) return -1;
+    carga_pular_espacos(cur, fim);
+    *valor = (int)v;
+    return 0;
+}
+
+// Indica se a linha iniciada em `linha` deve ser lida como registro. Só são ignoradas
+// linhas em branco, comentários ('#') e a primeira linha não vazia, se não tiver dígitos
+// (cabeçalho); qualquer outra linha vai para o leitor, que rejeita as malformadas.
+// *primeira indica se ainda não apareceu nenhuma linha não vazia e é atualizado.
+static inline int carga_linha_eh_registro(const char *linha, const char *fim, int *primeira) {
+    carga_pular_espacos(&linha, fim);
+    if (linha == fim || *linha == '#') return 0;
+    if (*primeira) {
+        *primeira = 0;
+        for (; linha < fim; linha++) {
+            if (*linha >= '0' && *linha <= '9') return 1;
+        }
+        return 0;
+    }
+    return 1;
+}
+
+// Abre e mapeia o arquivo, detectando o formato e contando os processos.
+// Retorna 0 em caso de sucesso e -1 em caso de erro (mensagem em stderr).
+static inline int carga_abrir(LeitorCarga *c, const char *caminho) {
+    struct stat info;
+    int fd = open(caminho, O_RDONLY);
+    memset(c, 0, sizeof(*c));
+    c->caminho = caminho;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        fprintf(stderr, "Erro: Não foi possível abrir o arquivo de carga '%s'.\n", caminho);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    c->tamanho = (size_t)info.st_size;
+    if (c->tamanho == 0) {
+        fprintf(stderr, "Erro: O arquivo de carga '%s' está vazio.\n", caminho);
+        close(fd);
+        return -1;
+    }
+    c->dados = (const char *)mmap(NULL, c->tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // O mapeamento continua válido após fechar o descritor
+    if (c->dados == MAP_FAILED) {
+        fprintf(stderr, "Erro: Falha ao mapear o arquivo de carga '%s' em memória.\n", caminho);
+        c->dados = NULL;
+        return -1;
+    }
+    madvise((void *)c->dados, c->tamanho, MADV_SEQUENTIAL);
+
+    if (c->tamanho >= sizeof(CargaCabecalho) && memcmp(c->dados, CARGA_MAGICO, 4) == 0) {
+        const CargaCabecalho *cab = (const CargaCabecalho *)c->dados;
+        c->binario = 1;
+        if (cab->versao != CARGA_VERSAO ||
+            cab->quantidade > (uint64_t)INT_MAX ||
+            cab->quantidade > (c->tamanho - sizeof(CargaCabecalho)) / sizeof(CargaRegistro)) {
+            fprintf(stderr, "Erro: Cabeçalho inválido ou arquivo truncado em '%s'.\n", caminho);
+            munmap((void *)c->dados, c->tamanho);
+            c->dados = NULL;
+            return -1;
+        }
+        c->quantidade = (long)cab->quantidade;
+        c->cursor = c->dados + sizeof(CargaCabecalho);
+    } else {
+        // CSV: conta as linhas que contêm registros (memchr percorre o arquivo rapidamente)
+        const char *fim = c->dados + c->tamanho;
+        const char *linha = c->dados;
+        int primeira = 1;
+        while (linha < fim) {
+            const char *nl = (const char *)memchr(linha, '\n', (size_t)(fim - linha));
+            if (carga_linha_eh_registro(linha, nl != NULL ? nl : fim, &primeira)) c->quantidade++;
+            linha = nl != NULL ? nl + 1 : fim;
+        }
+        if (c->quantidade > INT_MAX) {
+            fprintf(stderr, "Erro: O arquivo de carga '%s' tem processos demais.\n", caminho);
+            munmap((void *)c->dados, c->tamanho);
+            c->dados = NULL;
+            return -1;
+        }
+        c->cursor = c->dados;
+        c->antes_do_primeiro = 1;
+    }
+    return 0;
+}
+
+static inline long carga_quantidade(const LeitorCarga *c) {
+    return c->quantidade;
+}
+
+// Entrega o próximo processo do arquivo. Retorna 1 se um processo foi lido,
+// 0 no fim do arquivo e -1 se o registro for inválido (mensagem em stderr).
+static inline int carga_proximo(LeitorCarga *c, int *chegada, int *duracao, int *prioridade) {
+    const char *fim = c->dados + c->tamanho;
+    if (c->lidos >= c->quantidade) return 0;
+
+    if (c->binario) {
+        const CargaRegistro *r = (const CargaRegistro *)c->cursor;
+        *chegada = r->chegada;
+        *duracao = r->duracao;
+        *prioridade = r->prioridade;
+        c->cursor += sizeof(CargaRegistro);
+    } else {
+        const char *nl;
+        // Avança até a próxima linha que contém um registro
+        for (;;) {
+            nl = (const char *)memchr(c->cursor, '\n', (size_t)(fim - c->cursor));
+            if (nl == NULL) nl = fim;
+            c->linha++;
+            if (carga_linha_eh_registro(c->cursor, nl, &c->antes_do_primeiro)) break;
+            c->cursor = nl < fim ? nl + 1 : fim;
+        }
+        *prioridade = 0;
+        if (carga_ler_inteiro(&c->cursor, nl, chegada) != 0 ||
+            c->cursor >= nl || *c->cursor++ != ',' ||
+            carga_ler_inteiro(&c->cursor, nl, duracao) != 0 ||
+            (c->cursor < nl && (*c->cursor++ != ',' || carga_ler_inteiro(&c->cursor, nl, prioridade) != 0)) ||
+            c->cursor != nl) {
+            fprintf(stderr, "Erro: Linha %ld de '%s' inválida (esperado chegada,duracao[,prioridade]).\n",
+                    c->linha, c->caminho);
+            return -1;
+        }
+        c->cursor = nl < fim ? nl + 1 : fim;
+    }
+    c->lidos++;
+
+    if (*chegada < 0 || *duracao <= 0 || *prioridade < 0) {
+        fprintf(stderr, "Erro: Processo %ld de '%s' inválido (chegada >= 0, duração > 0, prioridade >= 0).\n",
+                c->lidos, c->caminho);
+        return -1;
+    }
+    return 1;
+}
+
+// Devolve ao sistema as páginas do arquivo já lidas (para leituras em fluxo, que não
+// voltam atrás): sem isso, as páginas mapeadas continuam contando na memória residente.
+static inline void carga_liberar_lidos(LeitorCarga *c) {
+    size_t pagina = (size_t)sysconf(_SC_PAGESIZE);
+    size_t lidos = (size_t)(c->cursor - c->dados) / pagina * pagina;
+    if (lidos > 0) {
+        madvise((void *)c->dados, lidos, MADV_DONTNEED);
+    }
+}
+
+static inline void carga_fechar(LeitorCarga *c) {
+    if (c->dados != NULL) {
+        munmap((void *)c->dados, c->tamanho);
+        c->dados = NULL;
+    }
+}
+
+#endif // CARGA_H
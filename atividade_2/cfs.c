@@ -0,0 +1,479 @@
+/*
+ * Escalonador Justo (no estilo do CFS do Linux)
+ * Este programa simula um escalonador de compartilhamento proporcional: cada processo
+ * recebe a CPU na proporção do seu peso, derivado do campo prioridade como o "nice"
+ * do Linux (prioridade 0 a 39 equivale a nice -20 a 19; valores maiores que 39 contam
+ * como 39). Cada processo acumula um tempo de execução virtual (vruntime), que cresce
+ * mais devagar quanto maior o peso, e a CPU vai sempre para o processo pronto de menor
+ * vruntime.
+ *
+ * - Os processos prontos ficam em uma árvore rubro-negra ordenada por vruntime ->
+ *   chegada -> ID (arvore_rb.h), com o mínimo em cache: a escolha custa O(1) e a
+ *   reinserção O(log n), mesmo com 10^6 processos prontos.
+ * - A fatia do processo escolhido é a sua parte do período de latência (-l), em
+ *   proporção ao peso, e nunca menor que a granularidade mínima (-g). Com muitos
+ *   processos prontos o período cresce para prontos * granularidade, como no Linux.
+ * - Um processo que chega entra com o vruntime mínimo atual (não leva vantagem por ter
+ *   esperado fora do sistema) e preempta o processo em execução se este estiver à
+ *   frente dele por mais de uma granularidade mínima (convertida em vruntime).
+ *
+ * Justiça: o serviço ideal de um processo é o que ele receberia em um processador de
+ * compartilhamento generalizado (GPS), que divide a CPU continuamente entre os prontos
+ * em proporção aos pesos. Com o tempo virtual global V (dV/dt = 1 / soma dos pesos
+ * prontos), o serviço ideal de um processo desde a chegada é peso * (V - V_chegada),
+ * calculado em O(1) por evento. O desvio de um processo é a maior diferença, em módulo,
+ * entre o serviço ideal e o recebido ao longo da vida; ela só pode ser máxima ao ganhar
+ * ou perder a CPU, que é quando é medida.
+ *
+ * Compilação: gcc -O2 -o cfs cfs.c -lm
+ * Uso: ./cfs [-e arquivo_de_carga] [-s tabela|csv|binario|resumo] [-o arquivo_de_saida]
+ *            [-l latencia] [-g granularidade_minima]
+ *   -l: período em que todo processo pronto deve executar ao menos uma vez (padrão: 24)
+ *   -g: menor fatia concedida a um processo (padrão: 3)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>     // Para malloc, free, atoi
+#include <math.h>       // Para fabs, llround
+#include <unistd.h>     // Para getopt
+#include "arvore_rb.h"  // Árvore rubro-negra indexada usada como fila de prontos
+#include "ordenacao.h"  // Radix sort das chegadas e comparador especializado
+#include "carga.h"      // Leitura da carga de trabalho a partir de arquivo (CSV ou binário)
+#include "saida.h"      // Escrita dos resultados (tabela, CSV, binário ou resumo)
+#include "histograma.h" // Percentis de espera, retorno e desvio em memória fixa
+
+#define LATENCIA_PADRAO 24
+#define GRANULARIDADE_PADRAO 3
+#define VRUNTIME_BITS 20     // vruntime em 1/2^20 de unidade de tempo ponderada
+
+// Peso de cada nice, de -20 a 19 (tabela sched_prio_to_weight do Linux): cada nível
+// a mais custa cerca de 10% de CPU em relação ao vizinho
+static const int pesos_nice[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15,
+};
+
+// Estrutura que representa um processo
+typedef struct {
+    int id;                 // Identificador do processo
+    int chegada;            // Tempo de chegada do processo
+    int duracao_original;   // Duração original (tempo de execução total)
+    int prioridade;         // Prioridade do processo (define o peso)
+    int peso;               // Peso no compartilhamento da CPU
+    int restante;           // Tempo restante de execução para o processo
+    int inicio;             // Momento em que o processo começa a executar pela primeira vez
+    int termino;            // Momento em que o processo termina sua execução
+    int espera;             // Tempo total de espera do processo
+    int retorno;            // Tempo total de retorno (turnaround)
+    int finalizado;         // Flag: 1 se o processo terminou, 0 caso contrário
+    long long vruntime;     // Tempo de execução virtual (ordem da árvore)
+    double v_chegada;       // Tempo virtual global V na chegada do processo
+    double desvio;          // Maior |serviço ideal - serviço recebido| até agora
+} Processo;
+
+// Ordena índices de processos pela chegada; o radix sort é estável, então o empate
+// fica com a ordem inicial dos índices, que é a dos IDs
+#define CHAVE_CHEGADA(idx, p) ((p)[idx].chegada)
+ORDENACAO_RADIX(ordenar_por_chegada, int, const Processo *, CHAVE_CHEGADA)
+
+// Ordem da árvore de prontos: menor vruntime, depois menor chegada, depois menor ID
+COMPARADOR_PROCESSOS(comparar_vruntime, Processo, vruntime)
+
+// Peso correspondente à prioridade (0 = nice -20, o maior peso)
+int peso_prioridade(int prioridade) {
+    return pesos_nice[prioridade < 40 ? prioridade : 39];
+}
+
+// Converte tempo real em vruntime para um processo de peso `peso`
+long long tempo_virtual(long long tempo, int peso) {
+    return (tempo << VRUNTIME_BITS) / peso;
+}
+
+// Atualiza o maior desvio do processo no instante de tempo virtual V
+void medir_desvio(Processo *p, double v) {
+    double ideal = p->peso * (v - p->v_chegada);
+    double recebido = p->duracao_original - p->restante;
+    if (fabs(ideal - recebido) > p->desvio) {
+        p->desvio = fabs(ideal - recebido);
+    }
+}
+
+// Lê os processos interativamente pelo terminal.
+// Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+Processo *ler_processos_terminal(int *n) {
+    Processo *p;
+    int i;
+
+    // Entrada do número de processos
+    printf("Informe o número de processos: ");
+    if (scanf("%d", n) != 1 || *n <= 0) {
+        fprintf(stderr, "Erro: Número de processos deve ser um inteiro positivo.\n");
+        return NULL;
+    }
+
+    // Alocação dinâmica de memória para os processos
+    p = (Processo *)malloc(*n * sizeof(Processo));
+    if (p == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
+        return NULL;
+    }
+
+    // Entrada dos dados dos processos
+    printf("\n--- Entrada dos Dados dos Processos ---\n");
+    for (i = 0; i < *n; i++) {
+        p[i].id = i + 1;
+        printf("Processo %d:\n", p[i].id);
+        printf("  Tempo de chegada: ");
+        if (scanf("%d", &p[i].chegada) != 1 || p[i].chegada < 0) {
+            fprintf(stderr, "Erro: Tempo de chegada inválido para o processo %d (deve ser >= 0).\n", p[i].id);
+            free(p);
+            return NULL;
+        }
+        printf("  Duração (burst): ");
+        if (scanf("%d", &p[i].duracao_original) != 1 || p[i].duracao_original <= 0) {
+            fprintf(stderr, "Erro: Duração inválida para o processo %d (deve ser > 0).\n", p[i].id);
+            free(p);
+            return NULL;
+        }
+        printf("  Prioridade (0 a 39, como nice -20 a 19): ");
+        if (scanf("%d", &p[i].prioridade) != 1 || p[i].prioridade < 0) {
+            fprintf(stderr, "Erro: Prioridade inválida para o processo %d (deve ser >= 0).\n", p[i].id);
+            free(p);
+            return NULL;
+        }
+    }
+    return p;
+}
+
+// Lê todos os processos de um arquivo de carga (CSV ou binário) em uma única passada.
+// Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+Processo *carregar_arquivo(const char *caminho, int *n) {
+    LeitorCarga carga;
+    Processo *p;
+    int i;
+
+    if (carga_abrir(&carga, caminho) != 0) return NULL;
+    *n = (int)carga_quantidade(&carga);
+    if (*n <= 0) {
+        fprintf(stderr, "Erro: O arquivo '%s' não contém processos.\n", caminho);
+        carga_fechar(&carga);
+        return NULL;
+    }
+    p = (Processo *)malloc(*n * sizeof(Processo));
+    if (p == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
+        carga_fechar(&carga);
+        return NULL;
+    }
+    for (i = 0; i < *n; i++) {
+        p[i].id = i + 1;
+        if (carga_proximo(&carga, &p[i].chegada, &p[i].duracao_original, &p[i].prioridade) != 1) {
+            free(p);
+            carga_fechar(&carga);
+            return NULL;
+        }
+    }
+    carga_fechar(&carga);
+    printf("%d processos carregados de '%s'.\n", *n, caminho);
+    return p;
+}
+
+// Escreve o resultado de cada processo no formato escolhido (ver saida.h).
+// Retorna 0 em caso de sucesso e -1 em caso de erro.
+int exibir_resultados(const Processo *p, int n, FormatoSaida formato, const char *arquivo_saida) {
+    EscritorResultados saida;
+    LinhaResultado linha = {0}; // Colunas opcionais não usadas ficam zeradas
+    int i;
+
+    if (saida_abrir(&saida, formato, arquivo_saida, 1) != 0) return -1;
+    saida.com_desvio = 1;
+    saida_cabecalho(&saida, n);
+    if (formato != SAIDA_RESUMO) {
+        for (i = 0; i < n; i++) {
+            linha.id = p[i].id;
+            linha.chegada = p[i].chegada;
+            linha.duracao = p[i].duracao_original;
+            linha.prioridade = p[i].prioridade;
+            linha.inicio = p[i].inicio;
+            linha.termino = p[i].termino;
+            linha.espera = p[i].espera;
+            linha.retorno = p[i].retorno;
+            linha.desvio = (int)llround(p[i].desvio);
+            saida_linha(&saida, &linha);
+        }
+    }
+    saida_rodape(&saida);
+    return saida_fechar(&saida);
+}
+
+int main(int argc, char *argv[]) {
+    Processo *p = NULL; // Ponteiro para o array de processos
+    int n, i;
+    int tempo_atual = 0;
+    int processos_finalizados = 0;
+    Histograma hist_espera, hist_retorno, hist_desvio; // Distribuições (média e percentis)
+    int *ordem_chegada = NULL;          // Índices dos processos ordenados por chegada
+    int proxima_chegada = 0;            // Cursor em ordem_chegada: próximo processo a chegar
+    ArvoreRB prontos;                   // Processos prontos, exceto o que está executando
+    int atual = -1;                     // Processo em execução, ou -1 se a CPU está ociosa
+    int fim_fatia = 0;                  // Instante em que a fatia do processo atual acaba
+    int inicio_fatia = 0;               // Instante em que a fatia atual começou
+    long long vruntime_inicio_fatia = 0; // vruntime do processo atual no início da fatia
+    long long min_vruntime = 0;         // Menor vruntime já visto entre os prontos (nunca diminui)
+    long long peso_total = 0;           // Soma dos pesos dos processos prontos (incluindo o atual)
+    double v = 0;                       // Tempo virtual global do GPS
+    long fatias = 0, trocas_contexto = 0, preempcoes_chegada = 0;
+    int ultimo_executado = -1;          // Último processo a ocupar a CPU (para contar as trocas)
+    int maior_desvio = -1;              // Índice do processo com o maior desvio
+    int latencia = LATENCIA_PADRAO;     // -l: período de latência
+    int granularidade = GRANULARIDADE_PADRAO; // -g: granularidade mínima
+    const char *arquivo_entrada = NULL; // -e: lê os processos de um arquivo em vez do terminal
+    const char *arquivo_saida = NULL;   // -o: grava os resultados em arquivo em vez da tela
+    FormatoSaida formato_saida = SAIDA_TABELA; // -s: formato dos resultados por processo
+    int formato_definido = 0;
+    int status = 0; // Código de saída (1 se a escrita dos resultados falhar)
+    int opcao;
+
+    while ((opcao = getopt(argc, argv, "e:s:o:l:g:")) != -1) {
+        switch (opcao) {
+        case 'e':
+            arquivo_entrada = optarg;
+            break;
+        case 's':
+            if (saida_formato(optarg, &formato_saida) != 0) {
+                fprintf(stderr, "Erro: Formato de saída inválido (use tabela, csv, binario ou resumo).\n");
+                return 1;
+            }
+            formato_definido = 1;
+            break;
+        case 'o':
+            arquivo_saida = optarg;
+            break;
+        case 'l':
+            latencia = atoi(optarg);
+            break;
+        case 'g':
+            granularidade = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Uso: %s [-e arquivo_de_carga] [-s tabela|csv|binario|resumo] [-o arquivo_de_saida]\n"
+                            "       [-l latencia] [-g granularidade_minima]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (latencia <= 0 || granularidade <= 0 || granularidade > latencia) {
+        fprintf(stderr, "Erro: Latência e granularidade devem ser positivas, com granularidade <= latência.\n");
+        return 1;
+    }
+
+    printf("## Escalonamento Justo (vruntime) ##\n");
+    printf("------------------------------------\n");
+    printf("(Prioridade 0 a 39 equivale a nice -20 a 19; latência %d, granularidade mínima %d)\n\n",
+           latencia, granularidade);
+
+    // Entrada dos processos: arquivo de carga (-e) ou, na falta dele, o terminal
+    if (arquivo_entrada != NULL) {
+        p = carregar_arquivo(arquivo_entrada, &n);
+    } else {
+        p = ler_processos_terminal(&n);
+    }
+    if (p == NULL) {
+        return 1;
+    }
+    for (i = 0; i < n; i++) {
+        p[i].peso = peso_prioridade(p[i].prioridade);
+        p[i].restante = p[i].duracao_original;
+        p[i].finalizado = 0;
+        p[i].inicio = -1; // Indica que ainda não começou
+        p[i].termino = 0;
+        p[i].espera = 0;
+        p[i].retorno = 0;
+        p[i].vruntime = 0;
+        p[i].desvio = 0;
+    }
+
+    // Índices dos processos ordenados por chegada (desempate pelo ID).
+    // Permite descobrir o próximo evento de chegada sem varrer todos os processos.
+    ordem_chegada = (int *)malloc(n * sizeof(int));
+    if (ordem_chegada == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a ordem de chegada!\n");
+        free(p);
+        return 1;
+    }
+    for (i = 0; i < n; i++) {
+        ordem_chegada[i] = i;
+    }
+    if (ordenar_por_chegada(ordem_chegada, n, p) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a ordem de chegada!\n");
+        free(ordem_chegada);
+        free(p);
+        return 1;
+    }
+
+    if (arvore_criar(&prontos, n, comparar_vruntime, p) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+        free(ordem_chegada);
+        free(p);
+        return 1;
+    }
+
+    hist_iniciar(&hist_espera);
+    hist_iniciar(&hist_retorno);
+    hist_iniciar(&hist_desvio);
+
+    printf("\n--- Executando Escalonamento Justo ---\n");
+
+    // Loop principal orientado a eventos: o relógio salta para o próximo término, fim
+    // de fatia ou chegada. Entre dois eventos o processo em execução não muda.
+    while (processos_finalizados < n) {
+        int proximo_evento, decorrido;
+
+        // Processos que já chegaram entram na árvore com o vruntime mínimo atual
+        while (proxima_chegada < n && p[ordem_chegada[proxima_chegada]].chegada <= tempo_atual) {
+            int idx = ordem_chegada[proxima_chegada];
+            p[idx].vruntime = min_vruntime;
+            p[idx].v_chegada = v;
+            peso_total += p[idx].peso;
+            arvore_inserir(&prontos, idx);
+            proxima_chegada++;
+
+            // Preempção na chegada: o atual está à frente do recém-chegado por mais de
+            // uma granularidade mínima (medida no vruntime do recém-chegado)
+            if (atual != -1 && fim_fatia > tempo_atual &&
+                p[atual].vruntime - p[idx].vruntime > tempo_virtual(granularidade, p[idx].peso)) {
+                fim_fatia = tempo_atual;
+                preempcoes_chegada++;
+            }
+        }
+
+        // Fim da fatia: o processo atual volta à árvore e o de menor vruntime é escolhido
+        // (que pode ser ele mesmo, sem troca de contexto)
+        if (atual != -1 && tempo_atual >= fim_fatia) {
+            arvore_inserir(&prontos, atual);
+            atual = -1;
+        }
+
+        if (atual == -1) {
+            long long prontos_total, periodo, fatia;
+
+            atual = arvore_remover_minimo(&prontos);
+            if (atual == -1) { // Nenhum processo pronto para executar agora
+                if (proxima_chegada == n) break; // Nada mais a executar
+
+                // CPU ociosa: avança o tempo diretamente para a próxima chegada
+                tempo_atual = p[ordem_chegada[proxima_chegada]].chegada;
+                ultimo_executado = -1;
+                continue;
+            }
+            if (atual != ultimo_executado) {
+                // O desvio só pode ser máximo quando um processo perde a CPU (maior
+                // adiantamento) ou a ganha (maior atraso)
+                if (ultimo_executado != -1) {
+                    medir_desvio(&p[ultimo_executado], v);
+                }
+                medir_desvio(&p[atual], v);
+                if (p[atual].inicio == -1) {
+                    p[atual].inicio = tempo_atual;
+                }
+                trocas_contexto++;
+                ultimo_executado = atual;
+            }
+
+            // Fatia: parte do período proporcional ao peso, nunca menor que a granularidade
+            prontos_total = prontos.tamanho + 1;
+            periodo = prontos_total * granularidade > latencia ? prontos_total * granularidade : latencia;
+            fatia = periodo * p[atual].peso / peso_total;
+            if (fatia < granularidade) fatia = granularidade;
+            if (fatia > p[atual].restante) fatia = p[atual].restante;
+            inicio_fatia = tempo_atual;
+            fim_fatia = tempo_atual + (int)fatia;
+            vruntime_inicio_fatia = p[atual].vruntime;
+            fatias++;
+        }
+
+        // Próximo evento: término, fim da fatia ou próxima chegada, o que vier antes
+        proximo_evento = fim_fatia;
+        if (proxima_chegada < n && p[ordem_chegada[proxima_chegada]].chegada < proximo_evento) {
+            proximo_evento = p[ordem_chegada[proxima_chegada]].chegada;
+        }
+
+        // Executa o processo até o próximo evento; o vruntime é recalculado desde o
+        // início da fatia para não acumular erros de arredondamento
+        decorrido = proximo_evento - tempo_atual;
+        p[atual].restante -= decorrido;
+        p[atual].vruntime = vruntime_inicio_fatia + tempo_virtual(proximo_evento - inicio_fatia, p[atual].peso);
+        v += (double)decorrido / peso_total;
+        tempo_atual = proximo_evento;
+
+        // min_vruntime acompanha o menor vruntime entre os prontos, sem nunca diminuir
+        {
+            long long menor = p[atual].vruntime;
+            if (!arvore_vazia(&prontos) && p[arvore_minimo(&prontos)].vruntime < menor) {
+                menor = p[arvore_minimo(&prontos)].vruntime;
+            }
+            if (menor > min_vruntime) min_vruntime = menor;
+        }
+
+        // Verifica se o processo terminou
+        if (p[atual].restante == 0) {
+            p[atual].termino = tempo_atual;
+            p[atual].retorno = p[atual].termino - p[atual].chegada;
+            p[atual].espera = p[atual].retorno - p[atual].duracao_original;
+            p[atual].finalizado = 1;
+            medir_desvio(&p[atual], v);
+            peso_total -= p[atual].peso;
+            processos_finalizados++;
+
+            // Registra nos histogramas (médias e percentis)
+            hist_registrar(&hist_espera, p[atual].espera);
+            hist_registrar(&hist_retorno, p[atual].retorno);
+            hist_registrar(&hist_desvio, llround(p[atual].desvio));
+            if (maior_desvio == -1 || p[atual].desvio > p[maior_desvio].desvio) {
+                maior_desvio = atual;
+            }
+            ultimo_executado = -1;
+            atual = -1;
+        }
+    }
+
+    // Exibe os resultados
+    // Formato padrão: tabela para execuções pequenas, apenas o resumo para as grandes
+    if (!formato_definido) {
+        formato_saida = saida_formato_padrao(n);
+    }
+    printf("\n--- Resultados do Escalonamento Justo ---\n");
+    if (exibir_resultados(p, n, formato_saida, arquivo_saida) != 0) {
+        status = 1;
+    }
+
+    if (n > 0) {
+        printf("\nTempo médio de espera: %.2f unidades de tempo\n", hist_media(&hist_espera));
+        printf("Tempo médio de retorno: %.2f unidades de tempo\n", hist_media(&hist_retorno));
+        hist_exibir_percentis("espera", &hist_espera);
+        hist_exibir_percentis("retorno", &hist_retorno);
+        printf("\nDesvio médio do serviço justo (GPS): %.2f unidades de tempo\n", hist_media(&hist_desvio));
+        hist_exibir_percentis("desvio", &hist_desvio);
+        printf("Maior desvio: %.2f unidades de tempo (processo %d)\n",
+               p[maior_desvio].desvio, p[maior_desvio].id);
+        printf("Fatias: %ld | Trocas de contexto: %ld | Preempções na chegada: %ld\n",
+               fatias, trocas_contexto, preempcoes_chegada);
+    }
+    printf("\nSimulação concluída.\n");
+
+    // Liberação da memória dinâmica
+    arvore_destruir(&prontos);
+    free(ordem_chegada);
+    ordem_chegada = NULL;
+    if (p != NULL) {
+        free(p);
+        p = NULL;
+    }
+
+    return status;
+}
@@ -0,0 +1,267 @@
+/*
+ * Checkpoints (instantâneos) do estado de uma simulação, para pausar e retomar
+ * execuções longas.
+ * O simulador descreve o seu estado como uma sequência de seções (blocos de bytes:
+ * escalares, vetor de processos, fila de prontos, histogramas...) e o arquivo guarda
+ * essas seções na mesma ordem, em ordem de bytes nativa: cabeçalho CheckpointCabecalho
+ * ("ESCK", versão, nome da política, tamanho e soma de verificação FNV-1a dos dados)
+ * seguido, para cada seção, de um uint64 com o tamanho e dos bytes dela. A retomada lê
+ * as seções na mesma ordem e confere o tamanho de cada uma.
+ *
+ * O arquivo é gravado primeiro em "<caminho>.tmp" e depois renomeado sobre o anterior,
+ * de modo que uma interrupção no meio da gravação nunca destrói o último checkpoint
+ * válido. O buffer do escritor é reaproveitado entre um checkpoint e o seguinte.
+ *
+ * Uso típico:
+ *     EscritorCheckpoint e = {0};
+ *     checkpoint_iniciar(&e);
+ *     checkpoint_secao(&e, &escalares, sizeof(escalares));
+ *     checkpoint_secao(&e, processos, n * sizeof(Processo));
+ *     checkpoint_gravar(&e, caminho, "Round Robin");
+ *     ...
+ *     LeitorCheckpoint l;
+ *     checkpoint_abrir(&l, caminho, "Round Robin");
+ *     checkpoint_ler(&l, &escalares, sizeof(escalares));
+ *     checkpoint_ler(&l, processos, n * sizeof(Processo));
+ *     checkpoint_fechar(&l);
+ *
+ * Uso: basta incluir este arquivo; as funções são `static inline`.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdio.h>   // Para fprintf, snprintf, rename
+#include <stdint.h>  // Para uint32_t, uint64_t
+#include <stdlib.h>  // Para malloc, realloc, free
+#include <string.h>  // Para memcpy, memcmp, strncpy, strlen
+#include <fcntl.h>   // Para open
+#include <unistd.h>  // Para read, write, fsync, close
+#include <sys/stat.h> // Para fstat
+
+#define CHECKPOINT_MAGICO "ESCK"
+#define CHECKPOINT_VERSAO 1
+
+typedef struct {
+    char magico[4];     // Sempre "ESCK"
+    uint32_t versao;    // CHECKPOINT_VERSAO
+    char politica[24];  // Política que gravou o checkpoint (terminado em '\0')
+    uint64_t tamanho;   // Bytes de seções que seguem o cabeçalho
+    uint64_t soma;      // FNV-1a de 64 bits desses bytes
+} CheckpointCabecalho;
+
+typedef struct {
+    char *dados;        // Seções acumuladas (sem o cabeçalho)
+    size_t usado;
+    size_t capacidade;
+    int erro;           // 1 se faltou memória em alguma seção
+} EscritorCheckpoint;
+
+typedef struct {
+    char *dados;        // Arquivo inteiro, lido para a memória
+    size_t tamanho;
+    size_t cursor;      // Próximo byte de seção a ser lido
+} LeitorCheckpoint;
+
+// Soma de verificação FNV-1a de 64 bits
+static inline uint64_t checkpoint_soma(const char *dados, size_t tamanho) {
+    uint64_t h = 14695981039346656037ULL;
+    size_t i;
+    for (i = 0; i < tamanho; i++) {
+        h ^= (unsigned char)dados[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Começa um novo checkpoint (descarta as seções do anterior, mantendo o buffer)
+static inline void checkpoint_iniciar(EscritorCheckpoint *e) {
+    e->usado = 0;
+    e->erro = 0;
+}
+
+// Acrescenta uma seção com `tamanho` bytes a partir de `dados`
+static inline void checkpoint_secao(EscritorCheckpoint *e, const void *dados, size_t tamanho) {
+    uint64_t t = tamanho;
+    size_t necessario = e->usado + sizeof(t) + tamanho;
+    if (e->erro) return;
+    if (necessario > e->capacidade) {
+        size_t nova_capacidade = e->capacidade > 0 ? e->capacidade : 4096;
+        char *novos;
+        while (nova_capacidade < necessario) nova_capacidade *= 2;
+        novos = (char *)realloc(e->dados, nova_capacidade);
+        if (novos == NULL) {
+            e->erro = 1;
+            return;
+        }
+        e->dados = novos;
+        e->capacidade = nova_capacidade;
+    }
+    memcpy(e->dados + e->usado, &t, sizeof(t));
+    if (tamanho > 0) memcpy(e->dados + e->usado + sizeof(t), dados, tamanho);
+    e->usado = necessario;
+}
+
+// Escreve todo o bloco no descritor. Retorna 0 ou -1 em caso de erro.
+static inline int checkpoint_escrever(int fd, const char *dados, size_t tamanho) {
+    while (tamanho > 0) {
+        ssize_t escritos = write(fd, dados, tamanho);
+        if (escritos <= 0) return -1;
+        dados += escritos;
+        tamanho -= (size_t)escritos;
+    }
+    return 0;
+}
+
+// Grava as seções acumuladas em `caminho` (via "<caminho>.tmp" + rename).
+// Retorna 0 em caso de sucesso e -1 em caso de erro (mensagem em stderr).
+static inline int checkpoint_gravar(EscritorCheckpoint *e, const char *caminho, const char *politica) {
+    CheckpointCabecalho cab;
+    char *temporario;
+    int fd, falhou;
+
+    if (e->erro) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para o checkpoint!\n");
+        return -1;
+    }
+    temporario = (char *)malloc(strlen(caminho) + 5);
+    if (temporario == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para o checkpoint!\n");
+        return -1;
+    }
+    snprintf(temporario, strlen(caminho) + 5, "%s.tmp", caminho);
+
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magico, CHECKPOINT_MAGICO, 4);
+    cab.versao = CHECKPOINT_VERSAO;
+    strncpy(cab.politica, politica, sizeof(cab.politica) - 1);
+    cab.tamanho = e->usado;
+    cab.soma = checkpoint_soma(e->dados, e->usado);
+
+    fd = open(temporario, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Erro: Não foi possível criar o checkpoint '%s'.\n", temporario);
+        free(temporario);
+        return -1;
+    }
+    falhou = checkpoint_escrever(fd, (const char *)&cab, sizeof(cab)) != 0 ||
+             checkpoint_escrever(fd, e->dados, e->usado) != 0 ||
+             fsync(fd) != 0;
+    falhou = close(fd) != 0 || falhou;
+    if (falhou || rename(temporario, caminho) != 0) {
+        fprintf(stderr, "Erro: Falha ao gravar o checkpoint '%s'.\n", caminho);
+        unlink(temporario);
+        free(temporario);
+        return -1;
+    }
+    free(temporario);
+    return 0;
+}
+
+static inline void checkpoint_liberar(EscritorCheckpoint *e) {
+    free(e->dados);
+    e->dados = NULL;
+    e->usado = e->capacidade = 0;
+}
+
+// Mensagem única para checkpoints rejeitados: soma de verificação errada ou, depois de
+// carregado, um estado inconsistente (índices fora da faixa, de outra versão ou outro n)
+static inline void checkpoint_rejeitar(const char *caminho) {
+    fprintf(stderr, "Erro: '%s' não é um checkpoint válido (arquivo truncado ou corrompido?).\n", caminho);
+}
+
+// Indica se os k índices de `indices` estão em [0, n) e não se repetem (1) ou não (0;
+// também se faltar memória para a conferência).
+static inline int checkpoint_indices_validos(const int *indices, long k, int n) {
+    char *visto = (char *)calloc(n > 0 ? (size_t)n : 1, 1);
+    long i;
+    int validos = visto != NULL;
+    for (i = 0; validos && i < k; i++) {
+        if (indices[i] < 0 || indices[i] >= n || visto[indices[i]]) validos = 0;
+        else visto[indices[i]] = 1;
+    }
+    free(visto);
+    return validos;
+}
+
+// Lê o checkpoint inteiro e confere cabeçalho, política e soma de verificação.
+// Retorna 0 em caso de sucesso e -1 em caso de erro (mensagem em stderr).
+static inline int checkpoint_abrir(LeitorCheckpoint *l, const char *caminho, const char *politica) {
+    CheckpointCabecalho cab;
+    struct stat info;
+    size_t lidos = 0;
+    int fd = open(caminho, O_RDONLY);
+
+    l->dados = NULL;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        fprintf(stderr, "Erro: Não foi possível abrir o checkpoint '%s'.\n", caminho);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    l->tamanho = (size_t)info.st_size;
+    l->dados = (char *)malloc(l->tamanho > 0 ? l->tamanho : 1);
+    if (l->dados == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para o checkpoint!\n");
+        close(fd);
+        return -1;
+    }
+    while (lidos < l->tamanho) {
+        ssize_t r = read(fd, l->dados + lidos, l->tamanho - lidos);
+        if (r <= 0) break;
+        lidos += (size_t)r;
+    }
+    close(fd);
+
+    if (lidos == l->tamanho && l->tamanho >= sizeof(cab)) {
+        memcpy(&cab, l->dados, sizeof(cab));
+    }
+    if (lidos != l->tamanho || l->tamanho < sizeof(cab) ||
+        memcmp(cab.magico, CHECKPOINT_MAGICO, 4) != 0 || cab.versao != CHECKPOINT_VERSAO ||
+        cab.tamanho != l->tamanho - sizeof(cab) ||
+        cab.soma != checkpoint_soma(l->dados + sizeof(cab), (size_t)cab.tamanho)) {
+        checkpoint_rejeitar(caminho);
+        free(l->dados);
+        l->dados = NULL;
+        return -1;
+    }
+    cab.politica[sizeof(cab.politica) - 1] = '\0';
+    if (strcmp(cab.politica, politica) != 0) {
+        fprintf(stderr, "Erro: O checkpoint '%s' foi gravado pela política '%s', não por '%s'.\n",
+                caminho, cab.politica, politica);
+        free(l->dados);
+        l->dados = NULL;
+        return -1;
+    }
+    l->cursor = sizeof(cab);
+    return 0;
+}
+
+// Tamanho da próxima seção (para alocar o destino antes de checkpoint_ler),
+// ou -1 se não houver mais seções
+static inline long long checkpoint_tamanho_secao(const LeitorCheckpoint *l) {
+    uint64_t t;
+    if (l->tamanho - l->cursor < sizeof(t)) return -1;
+    memcpy(&t, l->dados + l->cursor, sizeof(t));
+    return (long long)t;
+}
+
+// Copia a próxima seção para `destino`, que deve ter exatamente `tamanho` bytes.
+// Retorna 0 em caso de sucesso e -1 se a seção não existir ou tiver outro tamanho.
+static inline int checkpoint_ler(LeitorCheckpoint *l, void *destino, size_t tamanho) {
+    long long t = checkpoint_tamanho_secao(l);
+    if (t < 0 || (size_t)t != tamanho || l->tamanho - l->cursor - sizeof(uint64_t) < tamanho) {
+        fprintf(stderr, "Erro: Seção do checkpoint com tamanho inesperado (versão diferente do programa?).\n");
+        return -1;
+    }
+    l->cursor += sizeof(uint64_t);
+    if (tamanho > 0) memcpy(destino, l->dados + l->cursor, tamanho);
+    l->cursor += tamanho;
+    return 0;
+}
+
+static inline void checkpoint_fechar(LeitorCheckpoint *l) {
+    free(l->dados);
+    l->dados = NULL;
+}
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,187 @@
+/*
+ * Comparador de Políticas de Escalonamento
+ * Este programa lê uma carga de trabalho uma única vez e a simula com FCFS, SJF,
+ * SRTF, Round Robin e Prioridade ao mesmo tempo, cada política em uma thread, usando o
+ * motor compartilhado (motor.h). A carga é somente leitura e cada thread escreve
+ * apenas no seu próprio Resultado, então não há necessidade de sincronização além
+ * do pthread_join. Ao final é exibido um relatório com as políticas lado a lado.
+ *
+ * Compilação: gcc -O2 -pthread -o comparador comparador.c motor.c
+ * Uso: ./comparador [-e arquivo_de_carga] [-q quantum] [-d]
+ *   -e: lê os processos de um arquivo (CSV ou binário, ver carga.h)
+ *   -q: quantum do Round Robin (pedido pelo terminal se omitido)
+ *   -d: exibe também a espera de cada processo em cada política
+ */
+
+#include <stdio.h>
+#include <stdlib.h>  // Para atoi
+#include <unistd.h>  // Para getopt
+#include <pthread.h> // Para pthread_create, pthread_join
+#include "motor.h"
+
+#define N_POLITICAS 5
+
+// Argumento de cada thread: a carga compartilhada e o resultado exclusivo da thread
+typedef struct {
+    const CargaTrabalho *carga;
+    Resultado *resultado;
+    int erro;
+} TrabalhoThread;
+
+void *executar_politica(void *arg) {
+    TrabalhoThread *trabalho = (TrabalhoThread *)arg;
+    trabalho->erro = motor_executar(trabalho->carga, trabalho->resultado);
+    return NULL;
+}
+
+// Exibe uma linha da tabela de comparação com um valor real por política
+void linha_real(const char *metrica, const double valores[N_POLITICAS]) {
+    int k;
+    printf("| %-24s |", metrica);
+    for (k = 0; k < N_POLITICAS; k++) printf(" %14.2f |", valores[k]);
+    printf("\n");
+}
+
+// Exibe uma linha da tabela de comparação com um valor inteiro por política
+void linha_inteira(const char *metrica, const long long valores[N_POLITICAS]) {
+    int k;
+    printf("| %-24s |", metrica);
+    for (k = 0; k < N_POLITICAS; k++) printf(" %14lld |", valores[k]);
+    printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+    const Politica *politicas[N_POLITICAS] = {
+        &politica_fcfs, &politica_sjf, &politica_srtf, &politica_rr, &politica_prioridade
+    };
+    Resultado resultados[N_POLITICAS];
+    TrabalhoThread trabalhos[N_POLITICAS];
+    pthread_t threads[N_POLITICAS];
+    int thread_criada[N_POLITICAS];
+    CargaTrabalho carga;
+    const char *arquivo_entrada = NULL;
+    int quantum = 0, detalhar = 0;
+    int opcao, i, k;
+    double reais[N_POLITICAS];
+    long long inteiros[N_POLITICAS];
+    const char *separador = "+--------------------------+----------------+----------------+----------------+----------------+----------------+\n";
+
+    while ((opcao = getopt(argc, argv, "e:q:d")) != -1) {
+        switch (opcao) {
+        case 'e':
+            arquivo_entrada = optarg;
+            break;
+        case 'q':
+            quantum = atoi(optarg);
+            if (quantum <= 0) {
+                fprintf(stderr, "Erro: O valor do quantum deve ser um inteiro positivo.\n");
+                return 1;
+            }
+            break;
+        case 'd':
+            detalhar = 1;
+            break;
+        default:
+            fprintf(stderr, "Uso: %s [-e arquivo_de_carga] [-q quantum] [-d]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("Comparador de Políticas de Escalonamento\n");
+    printf("----------------------------------------\n");
+
+    // A carga é lida uma única vez para todas as políticas
+    if (motor_carregar(&carga, arquivo_entrada) != 0) {
+        return 1;
+    }
+    if (arquivo_entrada != NULL) {
+        printf("%d processos carregados de '%s'.\n", carga.n, arquivo_entrada);
+    }
+    if (quantum == 0) {
+        printf("\nInforme o valor do quantum (Round Robin): ");
+        if (scanf("%d", &quantum) != 1 || quantum <= 0) {
+            fprintf(stderr, "Erro: O valor do quantum deve ser um inteiro positivo.\n");
+            motor_liberar_carga(&carga);
+            return 1;
+        }
+    }
+
+    // Uma thread por política, todas sobre a mesma carga somente leitura
+    for (k = 0; k < N_POLITICAS; k++) {
+        if (motor_preparar_resultado(&resultados[k], &carga, politicas[k], quantum) != 0) {
+            fprintf(stderr, "Erro: Falha na alocação de memória para os resultados!\n");
+            while (k-- > 0) motor_liberar_resultado(&resultados[k]);
+            motor_liberar_carga(&carga);
+            return 1;
+        }
+        trabalhos[k].carga = &carga;
+        trabalhos[k].resultado = &resultados[k];
+        trabalhos[k].erro = 0;
+    }
+    for (k = 0; k < N_POLITICAS; k++) {
+        thread_criada[k] = pthread_create(&threads[k], NULL, executar_politica, &trabalhos[k]) == 0;
+        if (!thread_criada[k]) {
+            // Sem thread disponível: simula na própria thread principal
+            executar_politica(&trabalhos[k]);
+        }
+    }
+    for (k = 0; k < N_POLITICAS; k++) {
+        if (thread_criada[k]) pthread_join(threads[k], NULL);
+        if (trabalhos[k].erro != 0) {
+            fprintf(stderr, "Erro: Falha de memória ao simular a política %s.\n", politicas[k]->nome);
+            for (i = 0; i < N_POLITICAS; i++) motor_liberar_resultado(&resultados[i]);
+            motor_liberar_carga(&carga);
+            return 1;
+        }
+    }
+
+    // Relatório lado a lado
+    printf("\n--- Comparação das Políticas (%d processos, quantum %d) ---\n", carga.n, quantum);
+    printf("%s", separador);
+    printf("| %-24s |", "Métrica");
+    for (k = 0; k < N_POLITICAS; k++) printf(" %-14s |", politicas[k]->nome);
+    printf("\n%s", separador);
+    for (k = 0; k < N_POLITICAS; k++) reais[k] = (double)resultados[k].soma_espera / carga.n;
+    linha_real("Tempo médio de espera", reais);
+    for (k = 0; k < N_POLITICAS; k++) reais[k] = (double)resultados[k].soma_retorno / carga.n;
+    linha_real("Tempo médio de retorno", reais);
+    for (k = 0; k < N_POLITICAS; k++) inteiros[k] = hist_percentil(&resultados[k].hist_espera, 50.0);
+    linha_inteira("Espera p50", inteiros);
+    for (k = 0; k < N_POLITICAS; k++) inteiros[k] = hist_percentil(&resultados[k].hist_espera, 90.0);
+    linha_inteira("Espera p90", inteiros);
+    for (k = 0; k < N_POLITICAS; k++) inteiros[k] = hist_percentil(&resultados[k].hist_espera, 99.0);
+    linha_inteira("Espera p99", inteiros);
+    for (k = 0; k < N_POLITICAS; k++) inteiros[k] = resultados[k].maior_espera;
+    linha_inteira("Maior espera", inteiros);
+    for (k = 0; k < N_POLITICAS; k++) inteiros[k] = hist_percentil(&resultados[k].hist_retorno, 99.0);
+    linha_inteira("Retorno p99", inteiros);
+    for (k = 0; k < N_POLITICAS; k++) inteiros[k] = resultados[k].trocas_contexto;
+    linha_inteira("Trocas de contexto", inteiros);
+    for (k = 0; k < N_POLITICAS; k++) inteiros[k] = resultados[k].tempo_total;
+    linha_inteira("Tempo total", inteiros);
+    for (k = 0; k < N_POLITICAS; k++) reais[k] = resultados[k].segundos * 1000.0;
+    linha_real("Tempo de simulação (ms)", reais);
+    printf("%s", separador);
+
+    if (detalhar) {
+        printf("\n--- Tempo de espera por processo ---\n");
+        printf("%s", separador);
+        printf("| %-24s |", "ID (chegada/dur./prio.)");
+        for (k = 0; k < N_POLITICAS; k++) printf(" %-14s |", politicas[k]->nome);
+        printf("\n%s", separador);
+        for (i = 0; i < carga.n; i++) {
+            char rotulo[64];
+            snprintf(rotulo, sizeof(rotulo), "%d (%d/%d/%d)", i + 1,
+                     carga.chegada[i], carga.duracao[i], carga.prioridade[i]);
+            printf("| %-24s |", rotulo);
+            for (k = 0; k < N_POLITICAS; k++) printf(" %14d |", resultados[k].espera[i]);
+            printf("\n");
+        }
+        printf("%s", separador);
+    }
+    printf("\nComparação concluída.\n");
+
+    for (k = 0; k < N_POLITICAS; k++) motor_liberar_resultado(&resultados[k]);
+    motor_liberar_carga(&carga);
+    return 0;
+}
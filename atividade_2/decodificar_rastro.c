@@ -0,0 +1,267 @@
+/*
+ * Decodificador de Rastros de Execução
+ * Este programa lê um rastro binário gravado pelos escalonadores com a opção -t (ver
+ * rastro.h) e o exibe de uma das formas:
+ * - log (padrão): as linhas "Tempo t: Processo x está executando." que o escalonamento
+ *   por prioridade imprimia durante a simulação, agora para qualquer política;
+ * - gantt (-g): um diagrama de Gantt em texto, com uma linha por processo ('#' quando
+ *   executando, '.' quando pronto esperando) e o eixo do tempo comprimido para caber
+ *   na largura pedida;
+ * - eventos (-r): todos os registros, um por linha (tempo, processo, evento).
+ *
+ * O arquivo é lido em blocos, então o log e a lista de eventos usam memória constante;
+ * o Gantt guarda apenas a grade (processos exibidos x largura).
+ *
+ * Compilação: gcc -O2 -o decodificar_rastro decodificar_rastro.c
+ * Uso: ./decodificar_rastro [-g] [-r] [-l largura] [-n processos] arquivo_de_rastro
+ *   -g: diagrama de Gantt
+ *   -r: lista de eventos
+ *   -l: largura do eixo do tempo no Gantt, em colunas (padrão: 80)
+ *   -n: processos exibidos no Gantt, pelos menores IDs (padrão: 40)
+ */
+
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, calloc, free, atoi
+#include <string.h> // Para memcmp, memset
+#include <unistd.h> // Para getopt
+#include "rastro.h" // Formato do arquivo (RastroCabecalho, RastroRegistro)
+
+#define BLOCO_LEITURA 65536 // Registros lidos por vez
+
+typedef enum {
+    MODO_LOG,
+    MODO_GANTT,
+    MODO_EVENTOS
+} ModoExibicao;
+
+// Leitor sequencial do rastro em blocos
+typedef struct {
+    FILE *arquivo;
+    RastroCabecalho cabecalho;
+    RastroRegistro *bloco;
+    size_t lidos, posicao;
+} LeitorRastro;
+
+// Abre o rastro e valida o cabeçalho. Retorna 0 ou -1 em caso de erro.
+static int leitor_abrir(LeitorRastro *l, const char *caminho) {
+    l->arquivo = fopen(caminho, "rb");
+    if (l->arquivo == NULL) {
+        fprintf(stderr, "Erro: Não foi possível abrir o rastro '%s'.\n", caminho);
+        return -1;
+    }
+    if (fread(&l->cabecalho, sizeof(l->cabecalho), 1, l->arquivo) != 1 ||
+        memcmp(l->cabecalho.magico, RASTRO_MAGICO, 4) != 0 || l->cabecalho.versao != RASTRO_VERSAO) {
+        fprintf(stderr, "Erro: '%s' não é um rastro de execução válido (versão %d).\n", caminho, RASTRO_VERSAO);
+        fclose(l->arquivo);
+        return -1;
+    }
+    l->cabecalho.politica[sizeof(l->cabecalho.politica) - 1] = '\0';
+    l->bloco = (RastroRegistro *)malloc(BLOCO_LEITURA * sizeof(RastroRegistro));
+    if (l->bloco == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a leitura do rastro!\n");
+        fclose(l->arquivo);
+        return -1;
+    }
+    l->lidos = l->posicao = 0;
+    return 0;
+}
+
+// Volta ao primeiro registro (o Gantt lê o arquivo duas vezes)
+static void leitor_reiniciar(LeitorRastro *l) {
+    fseek(l->arquivo, sizeof(RastroCabecalho), SEEK_SET);
+    l->lidos = l->posicao = 0;
+}
+
+// Próximo registro, ou NULL no fim do arquivo
+static const RastroRegistro *leitor_proximo(LeitorRastro *l) {
+    if (l->posicao == l->lidos) {
+        l->lidos = fread(l->bloco, sizeof(RastroRegistro), BLOCO_LEITURA, l->arquivo);
+        l->posicao = 0;
+        if (l->lidos == 0) return NULL;
+    }
+    return &l->bloco[l->posicao++];
+}
+
+static void leitor_fechar(LeitorRastro *l) {
+    free(l->bloco);
+    fclose(l->arquivo);
+}
+
+static const char *nome_evento(int evento) {
+    switch (evento) {
+    case RASTRO_CHEGADA: return "chegada";
+    case RASTRO_EXECUCAO: return "execução";
+    case RASTRO_PREEMPCAO: return "preempção";
+    case RASTRO_TERMINO: return "término";
+    default: return "desconhecido";
+    }
+}
+
+// Log em texto: uma linha sempre que a CPU passa a um processo diferente do anterior
+// (ou volta a ser usada depois de um término ou de um período ociosa)
+static void exibir_log(LeitorRastro *l) {
+    const RastroRegistro *r;
+    int ultimo = -1;
+    while ((r = leitor_proximo(l)) != NULL) {
+        if (r->evento == RASTRO_EXECUCAO && r->processo != ultimo) {
+            printf("Tempo %d: Processo %d está executando.\n", r->tempo, r->processo);
+            ultimo = r->processo;
+        } else if (r->evento == RASTRO_TERMINO && r->processo == ultimo) {
+            ultimo = -1;
+        }
+    }
+}
+
+static void exibir_eventos(LeitorRastro *l) {
+    const RastroRegistro *r;
+    printf("%-10s %-10s %s\n", "Tempo", "Processo", "Evento");
+    while ((r = leitor_proximo(l)) != NULL) {
+        printf("%-10d %-10d %s\n", r->tempo, r->processo, nome_evento(r->evento));
+    }
+}
+
+// Marca na linha do processo as colunas do intervalo [inicio, fim) com `marca`. Com
+// `sobrepor` = 0 só escreve em colunas vazias (a espera não apaga a execução).
+static void marcar(char *linha, int largura, long long tempo_final, int inicio, int fim, char marca, int sobrepor) {
+    long long c, c_inicio, c_fim;
+    if (fim <= inicio) return;
+    c_inicio = (long long)inicio * largura / tempo_final;
+    c_fim = ((long long)fim * largura + tempo_final - 1) / tempo_final; // Arredonda para cima
+    if (c_fim > largura) c_fim = largura;
+    for (c = c_inicio; c < c_fim; c++) {
+        if (sobrepor || linha[c] == ' ') linha[c] = marca;
+    }
+}
+
+// Registros com processo < 1 ou tempo negativo não vêm dos escalonadores (arquivo
+// corrompido) e são ignorados pelo Gantt, que os usaria como índices da grade
+static int registro_valido(const RastroRegistro *r) {
+    return r->processo >= 1 && r->tempo >= 0;
+}
+
+// Indica se o processo `id` tem uma linha no diagrama
+static int exibido(int id, int exibidos) {
+    return id >= 1 && id <= exibidos;
+}
+
+// Diagrama de Gantt com uma linha por processo (IDs 1..max_processos)
+static int exibir_gantt(LeitorRastro *l, int largura, int max_processos) {
+    const RastroRegistro *r;
+    long long tempo_final = 0, eventos = 0, invalidos = 0;
+    int maior_id = 0, exibidos, atual = -1, inicio_atual = 0, i, c;
+    int *chegada;
+    char *grade;
+
+    // 1ª passada: fim do eixo do tempo e quantidade de processos
+    while ((r = leitor_proximo(l)) != NULL) {
+        if (!registro_valido(r)) {
+            invalidos++;
+            continue;
+        }
+        if (r->tempo > tempo_final) tempo_final = r->tempo;
+        if (r->processo > maior_id) maior_id = r->processo;
+        eventos++;
+    }
+    if (eventos == 0 || tempo_final == 0) {
+        printf("(rastro vazio)\n");
+        return 0;
+    }
+    exibidos = maior_id < max_processos ? maior_id : max_processos;
+    if (tempo_final < largura) largura = (int)tempo_final; // Uma coluna por unidade de tempo
+
+    grade = (char *)malloc((size_t)exibidos * largura);
+    chegada = (int *)calloc(exibidos + 1, sizeof(int));
+    if (grade == NULL || chegada == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para o diagrama!\n");
+        free(grade);
+        free(chegada);
+        return -1;
+    }
+    memset(grade, ' ', (size_t)exibidos * largura);
+
+    // 2ª passada: intervalos de execução ('#') e de espera ('.') de cada processo
+    leitor_reiniciar(l);
+    while ((r = leitor_proximo(l)) != NULL) {
+        int id = r->processo;
+        if (!registro_valido(r)) continue;
+        // Fecha a fatia do processo que estava na CPU
+        if (atual != -1 && (r->evento == RASTRO_EXECUCAO ||
+                            ((r->evento == RASTRO_PREEMPCAO || r->evento == RASTRO_TERMINO) && id == atual))) {
+            if (exibido(atual, exibidos)) {
+                marcar(grade + (size_t)(atual - 1) * largura, largura, tempo_final, inicio_atual, r->tempo, '#', 1);
+            }
+            atual = -1;
+        }
+        if (r->evento == RASTRO_EXECUCAO) {
+            atual = id;
+            inicio_atual = r->tempo;
+        } else if (exibido(id, exibidos) && r->evento == RASTRO_CHEGADA) {
+            chegada[id] = r->tempo;
+        } else if (exibido(id, exibidos) && r->evento == RASTRO_TERMINO) {
+            marcar(grade + (size_t)(id - 1) * largura, largura, tempo_final, chegada[id], r->tempo, '.', 0);
+        }
+    }
+
+    // Eixo do tempo: uma marca a cada 10 colunas
+    printf("%-8s ", "Tempo");
+    for (c = 0; c < largura; c += 10) {
+        char rotulo[16];
+        int tamanho = snprintf(rotulo, sizeof(rotulo), "%lld", (long long)c * tempo_final / largura);
+        printf("%-10s", tamanho <= 10 ? rotulo : "|");
+    }
+    printf("\n");
+    for (i = 0; i < exibidos; i++) {
+        printf("P%-7d |%.*s|\n", i + 1, largura, grade + (size_t)i * largura);
+    }
+    if (maior_id > exibidos) {
+        printf("(%d processos omitidos; use -n para exibir mais)\n", maior_id - exibidos);
+    }
+    if (invalidos > 0) {
+        printf("(%lld registros inválidos ignorados: processo < 1 ou tempo negativo)\n", invalidos);
+    }
+    printf("Escala: cada coluna vale %.2f unidades de tempo ('#' executando, '.' esperando).\n",
+           (double)tempo_final / largura);
+
+    free(grade);
+    free(chegada);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    LeitorRastro leitor;
+    ModoExibicao modo = MODO_LOG;
+    int largura = 80, max_processos = 40;
+    int opcao, status = 0;
+
+    while ((opcao = getopt(argc, argv, "grl:n:")) != -1) {
+        switch (opcao) {
+        case 'g': modo = MODO_GANTT; break;
+        case 'r': modo = MODO_EVENTOS; break;
+        case 'l': largura = atoi(optarg); break;
+        case 'n': max_processos = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Uso: %s [-g] [-r] [-l largura] [-n processos] arquivo_de_rastro\n", argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "Uso: %s [-g] [-r] [-l largura] [-n processos] arquivo_de_rastro\n", argv[0]);
+        return 1;
+    }
+    if (largura <= 0 || max_processos <= 0) {
+        fprintf(stderr, "Erro: Largura e número de processos devem ser inteiros positivos.\n");
+        return 1;
+    }
+    if (leitor_abrir(&leitor, argv[optind]) != 0) {
+        return 1;
+    }
+
+    printf("Rastro de execução: %s\n\n", leitor.cabecalho.politica);
+    switch (modo) {
+    case MODO_LOG: exibir_log(&leitor); break;
+    case MODO_EVENTOS: exibir_eventos(&leitor); break;
+    case MODO_GANTT: status = exibir_gantt(&leitor, largura, max_processos) != 0; break;
+    }
+    leitor_fechar(&leitor);
+    return status;
+}
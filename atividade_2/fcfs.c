@@ -8,13 +8,25 @@
  * - p[MAX]: vetor de processos
  * - n: quantidade de processos  
  * - tempo_atual: controla o tempo global de execução
- * - soma_espera, soma_retorno: acumuladores para médias
+ * - hist_espera, hist_retorno: histogramas de espera e retorno (médias e percentis)
+ * - rastro: rastro binário opcional da execução (-t, ver rastro.h e decodificar_rastro.c)
+ *
+ * Com a opção -f (requer -e), a carga é simulada em fluxo (ver fluxo.h): os processos são
+ * lidos do arquivo um a um, em ordem de chegada, e descartados ao terminar, de modo que
+ * a memória usada depende apenas de quantos processos estão no sistema ao mesmo tempo.
  */
 
 #include <stdio.h>
 #include <stdlib.h> // Para malloc e free
+#include <unistd.h> // Para getopt
+#include "ordenacao.h" // Radix sort dos processos por chegada
+#include "carga.h"  // Leitura da carga de trabalho a partir de arquivo (CSV ou binário)
+#include "saida.h"  // Escrita dos resultados (tabela, CSV, binário ou resumo)
+#include "histograma.h" // Percentis de espera e retorno em memória fixa
+#include "rastro.h"     // Rastro binário da execução (opção -t)
+#include "fluxo.h"      // Simulação em fluxo, sem guardar a carga (opção -f)
 
-// (Estrutura Processo e função comparar_processos permanecem iguais)
+// (Estrutura Processo permanece igual)
 typedef struct {
     int id;
     int chegada;
@@ -25,59 +37,268 @@ typedef struct {
     int retorno;
 } Processo;
 
-int comparar_processos(const void *a, const void *b) {
-    Processo *p1 = (Processo *)a;
-    Processo *p2 = (Processo *)b;
-    if (p1->chegada < p2->chegada) return -1;
-    if (p1->chegada > p2->chegada) return 1;
-    if (p1->id < p2->id) return -1;
-    if (p1->id > p2->id) return 1;
-    return 0;
-}
+// Ordena os processos pela chegada; o radix sort é estável, então o empate fica com a
+// ordem de leitura, que é a dos IDs
+#define CHAVE_PROCESSO(processo, contexto) ((processo).chegada)
+ORDENACAO_RADIX(ordenar_processos, Processo, const void *, CHAVE_PROCESSO)
 
 
-int main() {
-    Processo *p; // Ponteiro para Processo, em vez de um array estático
-    int n, i;
-    int tempo_atual = 0;
-    float soma_espera = 0, soma_retorno = 0;
+// Lê os processos interativamente pelo terminal.
+// Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+Processo *ler_processos_terminal(int *n) {
+    Processo *p;
+    int i;
 
-    printf("Algoritmo de Escalonamento FCFS (First-Come, First-Served)\n");
-    printf("---------------------------------------------------------\n");
     printf("Informe o número de processos: ");
-    if (scanf("%d", &n) != 1 || n <= 0) { // Adicionada verificação de n > 0 aqui
+    if (scanf("%d", n) != 1 || *n <= 0) { // Adicionada verificação de n > 0 aqui
         fprintf(stderr, "Erro: Número de processos deve ser positivo.\n");
-        return 1;
+        return NULL;
     }
 
     // Alocação dinâmica do array de processos
-    p = (Processo *)malloc(n * sizeof(Processo));
+    p = (Processo *)malloc(*n * sizeof(Processo));
     if (p == NULL) {
         fprintf(stderr, "Erro: Falha na alocação de memória!\n");
-        return 1; // Encerra se malloc falhar
+        return NULL; // Encerra se malloc falhar
     }
 
-    // Entrada dos dados dos processos (o resto do código é muito similar)
+    // Entrada dos dados dos processos
     printf("\n--- Entrada dos Dados dos Processos ---\n");
-    for (i = 0; i < n; i++) {
+    for (i = 0; i < *n; i++) {
         p[i].id = i + 1;
         printf("Processo %d:\n", p[i].id);
         printf("  Tempo de chegada: ");
         if (scanf("%d", &p[i].chegada) != 1 || p[i].chegada < 0) {
             fprintf(stderr, "Erro: Entrada inválida para o tempo de chegada.\n");
             free(p); // Libera memória antes de sair
-            return 1;
+            return NULL;
         }
         printf("  Duração (tempo de CPU): ");
         if (scanf("%d", &p[i].duracao) != 1 || p[i].duracao <= 0) {
             fprintf(stderr, "Erro: Entrada inválida para a duração.\n");
             free(p); // Libera memória antes de sair
+            return NULL;
+        }
+    }
+    return p;
+}
+
+// Lê todos os processos de um arquivo de carga (CSV ou binário) em uma única passada.
+// Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+Processo *carregar_arquivo(const char *caminho, int *n) {
+    LeitorCarga carga;
+    Processo *p;
+    int i, prioridade;
+
+    if (carga_abrir(&carga, caminho) != 0) return NULL;
+    *n = (int)carga_quantidade(&carga);
+    if (*n <= 0) {
+        fprintf(stderr, "Erro: O arquivo '%s' não contém processos.\n", caminho);
+        carga_fechar(&carga);
+        return NULL;
+    }
+    p = (Processo *)malloc(*n * sizeof(Processo));
+    if (p == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória!\n");
+        carga_fechar(&carga);
+        return NULL;
+    }
+    for (i = 0; i < *n; i++) {
+        p[i].id = i + 1;
+        if (carga_proximo(&carga, &p[i].chegada, &p[i].duracao, &prioridade) != 1) {
+            free(p);
+            carga_fechar(&carga);
+            return NULL;
+        }
+    }
+    carga_fechar(&carga);
+    printf("%d processos carregados de '%s'.\n", *n, caminho);
+    return p;
+}
+
+// Escreve o resultado de cada processo no formato escolhido (ver saida.h).
+// Retorna 0 em caso de sucesso e -1 em caso de erro.
+int exibir_resultados(const Processo *p, int n, FormatoSaida formato, const char *arquivo_saida) {
+    EscritorResultados saida;
+    LinhaResultado linha = {0}; // Colunas opcionais não usadas ficam zeradas
+    int i;
+
+    if (saida_abrir(&saida, formato, arquivo_saida, 0) != 0) return -1;
+    saida_cabecalho(&saida, n);
+    if (formato != SAIDA_RESUMO) {
+        for (i = 0; i < n; i++) {
+            linha.id = p[i].id;
+            linha.chegada = p[i].chegada;
+            linha.duracao = p[i].duracao;
+            linha.prioridade = 0;
+            linha.inicio = p[i].inicio;
+            linha.termino = p[i].termino;
+            linha.espera = p[i].espera;
+            linha.retorno = p[i].retorno;
+            saida_linha(&saida, &linha);
+        }
+    }
+    saida_rodape(&saida);
+    return saida_fechar(&saida);
+}
+
+// Escreve a linha de resultado de cada processo no momento em que ele termina (-f)
+void escrever_conclusao(const ConclusaoFluxo *c, void *contexto) {
+    EscritorResultados *saida = (EscritorResultados *)contexto;
+    LinhaResultado linha = {0}; // Colunas opcionais não usadas ficam zeradas
+    linha.id = c->id;
+    linha.chegada = c->chegada;
+    linha.duracao = c->duracao;
+    linha.inicio = c->inicio;
+    linha.termino = c->termino;
+    linha.espera = c->espera;
+    linha.retorno = c->retorno;
+    saida_linha(saida, &linha);
+}
+
+// Simula a carga do arquivo em fluxo (-f): cada chegada é lida e entregue ao simulador,
+// e cada resultado é escrito (na ordem de término) e descartado.
+// Retorna 0 em caso de sucesso e 1 em caso de erro.
+int simular_em_fluxo(const char *arquivo_entrada, FormatoSaida formato, int formato_definido,
+                     const char *arquivo_saida, Rastro *rastro) {
+    LeitorCarga carga;
+    SimuladorFluxo simulador;
+    EscritorResultados saida;
+    long n;
+    int status = 0;
+
+    if (carga_abrir(&carga, arquivo_entrada) != 0) return 1;
+    n = carga_quantidade(&carga);
+    if (fluxo_criar(&simulador, FLUXO_SEM_QUANTUM) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+        carga_fechar(&carga);
+        return 1;
+    }
+    if (!formato_definido) {
+        formato = saida_formato_padrao(n);
+    }
+    printf("%ld processos no arquivo '%s' (simulação em fluxo).\n", n, arquivo_entrada);
+    printf("\n--- Resultados do Escalonamento FCFS (em ordem de término) ---\n");
+    if (saida_abrir(&saida, formato, arquivo_saida, 0) != 0) {
+        fluxo_destruir(&simulador);
+        carga_fechar(&carga);
+        return 1;
+    }
+    saida_cabecalho(&saida, n);
+    if (formato != SAIDA_RESUMO) {
+        simulador.ao_concluir = escrever_conclusao;
+        simulador.contexto = &saida;
+    }
+    simulador.rastro = RASTRO_LIGADO(rastro) ? rastro : NULL;
+
+    if (fluxo_alimentar(&simulador, &carga) != 0 || fluxo_encerrar(&simulador) != 0) {
+        status = 1;
+    }
+    saida_rodape(&saida);
+    if (saida_fechar(&saida) != 0) {
+        status = 1;
+    }
+    carga_fechar(&carga);
+
+    if (status == 0 && simulador.concluidos > 0) {
+        printf("\nTempo médio de espera: %.2f unidades de tempo\n", hist_media(&simulador.hist_espera));
+        printf("Tempo médio de retorno: %.2f unidades de tempo\n", hist_media(&simulador.hist_retorno));
+        hist_exibir_percentis("espera", &simulador.hist_espera);
+        hist_exibir_percentis("retorno", &simulador.hist_retorno);
+        printf("Maior número de processos no sistema: %lld\n", simulador.maior_presenca);
+    }
+    fluxo_destruir(&simulador);
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    Processo *p; // Ponteiro para Processo, em vez de um array estático
+    int n, i;
+    int tempo_atual = 0;
+    Histograma hist_espera, hist_retorno; // Distribuição das esperas e dos retornos (média e percentis)
+    const char *arquivo_entrada = NULL; // -e: lê os processos de um arquivo em vez do terminal
+    const char *arquivo_saida = NULL;   // -o: grava os resultados em arquivo em vez da tela
+    FormatoSaida formato_saida = SAIDA_TABELA; // -s: formato dos resultados por processo
+    int formato_definido = 0;
+    Rastro rastro = {0};                // -t: rastro binário da execução (desligado por padrão)
+    const char *arquivo_rastro = NULL;
+    int em_fluxo = 0;                   // -f: simula sem guardar a carga na memória
+    int status = 0; // Código de saída (1 se a escrita dos resultados falhar)
+    int opcao;
+
+    while ((opcao = getopt(argc, argv, "e:s:o:t:f")) != -1) {
+        switch (opcao) {
+        case 'e':
+            arquivo_entrada = optarg;
+            break;
+        case 's':
+            if (saida_formato(optarg, &formato_saida) != 0) {
+                fprintf(stderr, "Erro: Formato de saída inválido (use tabela, csv, binario ou resumo).\n");
+                return 1;
+            }
+            formato_definido = 1;
+            break;
+        case 'o':
+            arquivo_saida = optarg;
+            break;
+        case 't':
+            arquivo_rastro = optarg;
+            break;
+        case 'f':
+            em_fluxo = 1;
+            break;
+        default:
+            fprintf(stderr, "Uso: %s [-e arquivo_de_carga [-f]] [-s tabela|csv|binario|resumo] [-o arquivo_de_saida] [-t arquivo_de_rastro]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("Algoritmo de Escalonamento FCFS (First-Come, First-Served)\n");
+    printf("---------------------------------------------------------\n");
+
+    if (em_fluxo) {
+        if (arquivo_entrada == NULL) {
+            fprintf(stderr, "Erro: A simulação em fluxo (-f) exige um arquivo de carga (-e).\n");
+            return 1;
+        }
+        if (arquivo_rastro != NULL && rastro_abrir(&rastro, arquivo_rastro, "FCFS") != 0) {
             return 1;
         }
+        status = simular_em_fluxo(arquivo_entrada, formato_saida, formato_definido, arquivo_saida, &rastro);
+        if (arquivo_rastro != NULL) {
+            long long eventos = rastro.total;
+            if (rastro_fechar(&rastro) != 0) {
+                status = 1;
+            } else {
+                printf("Rastro de execução: %lld eventos gravados em '%s'.\n", eventos, arquivo_rastro);
+            }
+        }
+        printf("\nSimulação FCFS concluída.\n");
+        return status;
+    }
+
+    // Entrada dos processos: arquivo de carga (-e) ou, na falta dele, o terminal
+    if (arquivo_entrada != NULL) {
+        p = carregar_arquivo(arquivo_entrada, &n);
+    } else {
+        p = ler_processos_terminal(&n);
+    }
+    if (p == NULL) {
+        return 1;
+    }
+    // Ordena os processos por chegada (radix sort, em tempo linear)
+    if (ordenar_processos(p, n, NULL) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a ordenação dos processos!\n");
+        free(p);
+        return 1;
+    }
+    if (arquivo_rastro != NULL && rastro_abrir(&rastro, arquivo_rastro, "FCFS") != 0) {
+        free(p);
+        return 1;
     }
 
-    // Ordena os processos (usando qsort, igual antes)
-    qsort(p, n, sizeof(Processo), comparar_processos);
+    hist_iniciar(&hist_espera);
+    hist_iniciar(&hist_retorno);
 
     // Calcula os tempos (lógica igual antes)
     // ... (código de cálculo dos tempos aqui) ...
@@ -91,29 +312,40 @@ int main() {
         p[i].espera = p[i].inicio - p[i].chegada;
         p[i].retorno = p[i].termino - p[i].chegada;
         tempo_atual = p[i].termino;
-        soma_espera += p[i].espera;
-        soma_retorno += p[i].retorno;
+        RASTRAR(&rastro, p[i].chegada, p[i].id, RASTRO_CHEGADA);
+        RASTRAR(&rastro, p[i].inicio, p[i].id, RASTRO_EXECUCAO);
+        RASTRAR(&rastro, p[i].termino, p[i].id, RASTRO_TERMINO);
+        hist_registrar(&hist_espera, p[i].espera);
+        hist_registrar(&hist_retorno, p[i].retorno);
     }
 
 
+    if (arquivo_rastro != NULL) {
+        long long eventos = rastro.total;
+        if (rastro_fechar(&rastro) != 0) {
+            status = 1;
+        } else {
+            printf("Rastro de execução: %lld eventos gravados em '%s'.\n", eventos, arquivo_rastro);
+        }
+    }
+
     // Exibe os resultados (lógica igual antes)
     // ... (código de exibição dos resultados aqui) ...
+    // Formato padrão: tabela para execuções pequenas, apenas o resumo para as grandes
+    if (!formato_definido) {
+        formato_saida = saida_formato_padrao(n);
+    }
     printf("\n--- Resultados do Escalonamento FCFS ---\n");
-    printf("+-----+---------+---------+--------+---------+--------+---------+\n");
-    printf("| %-3s | %-7s | %-7s | %-6s | %-7s | %-6s | %-7s |\n",
-           "ID", "Chegada", "Duração", "Início", "Término", "Espera", "Retorno");
-    printf("+-----+---------+---------+--------+---------+--------+---------+\n");
-    for (i = 0; i < n; i++) {
-        printf("| %-3d | %-7d | %-7d | %-6d | %-7d | %-6d | %-7d |\n",
-               p[i].id, p[i].chegada, p[i].duracao,
-               p[i].inicio, p[i].termino, p[i].espera, p[i].retorno);
+    if (exibir_resultados(p, n, formato_saida, arquivo_saida) != 0) {
+        status = 1;
     }
-    printf("+-----+---------+---------+--------+---------+--------+---------+\n");
 
 
     if (n > 0) {
-        printf("\nTempo médio de espera: %.2f unidades de tempo\n", soma_espera / n);
-        printf("Tempo médio de retorno: %.2f unidades de tempo\n", soma_retorno / n);
+        printf("\nTempo médio de espera: %.2f unidades de tempo\n", hist_media(&hist_espera));
+        printf("Tempo médio de retorno: %.2f unidades de tempo\n", hist_media(&hist_retorno));
+        hist_exibir_percentis("espera", &hist_espera);
+        hist_exibir_percentis("retorno", &hist_retorno);
     }
 
     // Libera a memória alocada dinamicamente
@@ -121,5 +353,5 @@ int main() {
     p = NULL; // Boa prática para evitar ponteiros "dangling"
 
     printf("\nSimulação FCFS concluída.\n");
-    return 0;
+    return status;
 }
\ No newline at end of file
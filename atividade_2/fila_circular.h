@@ -0,0 +1,85 @@
+/*
+ * Fila circular (ring buffer) crescente de índices de processos.
+ * Os índices de início e fim dão a volta no vetor, então posições liberadas por
+ * remoções são reaproveitadas. Quando a fila enche, a capacidade é dobrada e os
+ * elementos são copiados em ordem, o que dá inserção em O(1) amortizado e
+ * remoção em O(1). A capacidade é sempre uma potência de 2, de modo que o
+ * "dar a volta" é feito com uma máscara em vez de uma divisão.
+ *
+ * Uso: basta incluir este arquivo; as funções são `static inline`.
+ */
+
+#ifndef FILA_CIRCULAR_H
+#define FILA_CIRCULAR_H
+
+#include <stdlib.h> // Para malloc, free
+#include <string.h> // Para memcpy
+
+#define FILA_CAPACIDADE_INICIAL 16
+
+typedef struct {
+    int *itens;          // Vetor circular de índices
+    size_t capacidade;   // Tamanho do vetor (potência de 2)
+    size_t inicio;       // Posição do primeiro elemento
+    size_t tamanho;      // Quantidade de elementos na fila
+} FilaCircular;
+
+// Inicializa a fila vazia. Retorna 0 em caso de sucesso e -1 se a alocação falhar.
+static inline int fila_criar(FilaCircular *f) {
+    f->itens = (int *)malloc(FILA_CAPACIDADE_INICIAL * sizeof(int));
+    f->capacidade = FILA_CAPACIDADE_INICIAL;
+    f->inicio = 0;
+    f->tamanho = 0;
+    return f->itens != NULL ? 0 : -1;
+}
+
+static inline void fila_destruir(FilaCircular *f) {
+    free(f->itens);
+    f->itens = NULL;
+    f->capacidade = f->inicio = f->tamanho = 0;
+}
+
+static inline int fila_vazia(const FilaCircular *f) {
+    return f->tamanho == 0;
+}
+
+// Dobra a capacidade, copiando os elementos para o início do novo vetor
+static inline int fila_crescer(FilaCircular *f) {
+    size_t nova_capacidade = f->capacidade * 2;
+    int *novos = (int *)malloc(nova_capacidade * sizeof(int));
+    size_t ate_o_fim = f->capacidade - f->inicio; // Elementos antes de dar a volta
+    if (novos == NULL) return -1;
+    if (ate_o_fim >= f->tamanho) {
+        memcpy(novos, f->itens + f->inicio, f->tamanho * sizeof(int));
+    } else {
+        memcpy(novos, f->itens + f->inicio, ate_o_fim * sizeof(int));
+        memcpy(novos + ate_o_fim, f->itens, (f->tamanho - ate_o_fim) * sizeof(int));
+    }
+    free(f->itens);
+    f->itens = novos;
+    f->capacidade = nova_capacidade;
+    f->inicio = 0;
+    return 0;
+}
+
+// Insere idx no fim da fila. Retorna 0 em caso de sucesso e -1 se não houver memória.
+static inline int fila_inserir(FilaCircular *f, int idx) {
+    if (f->tamanho == f->capacidade && fila_crescer(f) != 0) {
+        return -1;
+    }
+    f->itens[(f->inicio + f->tamanho) & (f->capacidade - 1)] = idx;
+    f->tamanho++;
+    return 0;
+}
+
+// Remove e retorna o primeiro elemento da fila, ou -1 se ela estiver vazia
+static inline int fila_remover(FilaCircular *f) {
+    int idx;
+    if (f->tamanho == 0) return -1;
+    idx = f->itens[f->inicio];
+    f->inicio = (f->inicio + 1) & (f->capacidade - 1);
+    f->tamanho--;
+    return idx;
+}
+
+#endif // FILA_CIRCULAR_H
@@ -0,0 +1,232 @@
+/*
+ * Simulação em fluxo (online) do FCFS e do Round Robin.
+ * Em vez de receber a carga inteira antes da primeira decisão, o simulador recebe as
+ * chegadas uma a uma, em ordem de tempo, e avança a simulação até o instante de cada
+ * chegada antes de admiti-la. Cada processo que termina alimenta os histogramas, é
+ * entregue ao chamador (ao_concluir) e tem a sua entrada reaproveitada pelo próximo
+ * que chegar. A memória ocupada é, portanto, proporcional ao número de processos no
+ * sistema ao mesmo tempo (a fila de prontos), e não ao tamanho da carga: cargas de
+ * sistemas abertos, sem fim definido, podem ser simuladas.
+ *
+ * Os resultados são os mesmos da simulação em lote (motor.c, fcfs.c e round_robin.c):
+ * uma fatia que começa antes de uma chegada é executada por inteiro, e o processo
+ * preemptado volta à fila antes dos que chegaram durante a fatia. O FCFS é o Round
+ * Robin com quantum infinito (FLUXO_SEM_QUANTUM). A única diferença visível é a ordem
+ * das linhas de resultado, que saem na ordem de término.
+ *
+ * Uso típico:
+ *     SimuladorFluxo s;
+ *     fluxo_criar(&s, quantum);   // FLUXO_SEM_QUANTUM para FCFS
+ *     s.ao_concluir = funcao;     // opcional, recebe cada ConclusaoFluxo
+ *     while (...) fluxo_chegada(&s, id, chegada, duracao);  // chegadas em ordem de tempo
+ *     fluxo_encerrar(&s);         // executa o que restou na fila
+ *     fluxo_destruir(&s);
+ *
+ * Uso: basta incluir este arquivo; as funções são `static inline`.
+ */
+
+#ifndef FLUXO_H
+#define FLUXO_H
+
+#include <stdio.h>         // Para fprintf
+#include <stdlib.h>        // Para realloc, free
+#include <limits.h>        // Para INT_MAX
+#include "fila_circular.h" // Fila de prontos e lista de entradas livres
+#include "histograma.h"    // Percentis de espera e retorno em memória fixa
+#include "carga.h"         // Alimentação a partir de um arquivo de carga
+#include "rastro.h"        // Rastro binário opcional da execução
+
+#define FLUXO_SEM_QUANTUM INT_MAX // Quantum do FCFS: cada processo executa até terminar
+#define FLUXO_BLOCO_CARGA 65536   // Processos lidos do arquivo entre liberações das páginas já lidas
+
+// Processo presente no sistema (na fila de prontos ou na CPU)
+typedef struct {
+    int id;
+    int chegada;
+    int duracao;
+    int restante;
+    int inicio;     // -1 até a primeira fatia
+} TarefaFluxo;
+
+// Resultado de um processo, entregue ao chamador no momento do término
+typedef struct {
+    int id, chegada, duracao, inicio, termino, espera, retorno;
+} ConclusaoFluxo;
+
+typedef struct {
+    int quantum;
+    TarefaFluxo *tarefas;       // Entradas dos processos no sistema (reaproveitadas)
+    int capacidade;             // Tamanho de `tarefas`
+    int usadas;                 // Entradas já criadas (as livres voltam para `livres`)
+    FilaCircular prontos;       // Índices em `tarefas`, na ordem da fila de prontos
+    FilaCircular livres;        // Índices em `tarefas` desocupados por quem terminou
+    int tempo_atual;
+    int ultima_chegada;         // Para recusar chegadas fora de ordem
+    int ultimo_id;              // Processo da fatia anterior (0 se ele terminou)
+    long long admitidos;
+    long long concluidos;
+    long trocas_contexto;
+    long long maior_presenca;   // Maior número de processos no sistema ao mesmo tempo
+    Histograma hist_espera, hist_retorno;
+    void (*ao_concluir)(const ConclusaoFluxo *c, void *contexto); // Opcional
+    void *contexto;
+    Rastro *rastro;             // Opcional (NULL: sem rastro)
+} SimuladorFluxo;
+
+// Inicializa o simulador vazio no instante 0. Retorna 0 ou -1 se faltar memória.
+static inline int fluxo_criar(SimuladorFluxo *s, int quantum) {
+    memset(s, 0, sizeof(*s));
+    s->quantum = quantum;
+    if (fila_criar(&s->prontos) != 0 || fila_criar(&s->livres) != 0) {
+        fila_destruir(&s->prontos);
+        return -1;
+    }
+    hist_iniciar(&s->hist_espera);
+    hist_iniciar(&s->hist_retorno);
+    return 0;
+}
+
+static inline void fluxo_destruir(SimuladorFluxo *s) {
+    fila_destruir(&s->prontos);
+    fila_destruir(&s->livres);
+    free(s->tarefas);
+    s->tarefas = NULL;
+}
+
+// Processos que chegaram e ainda não terminaram
+static inline long long fluxo_presentes(const SimuladorFluxo *s) {
+    return s->admitidos - s->concluidos;
+}
+
+// Executa a fatia do primeiro processo da fila de prontos (que não pode estar vazia).
+// Retorna 0 ou -1 se faltar memória ao re-enfileirá-lo.
+static inline int fluxo_executar_fatia(SimuladorFluxo *s) {
+    int idx = fila_remover(&s->prontos);
+    TarefaFluxo *t = &s->tarefas[idx];
+    int fatia;
+
+    if (t->inicio == -1) {
+        t->inicio = s->tempo_atual;
+    }
+    if (t->id != s->ultimo_id) {
+        if (s->ultimo_id != 0 && s->rastro != NULL) {
+            RASTRAR(s->rastro, s->tempo_atual, s->ultimo_id, RASTRO_PREEMPCAO);
+        }
+        if (s->rastro != NULL) RASTRAR(s->rastro, s->tempo_atual, t->id, RASTRO_EXECUCAO);
+        s->trocas_contexto++;
+        s->ultimo_id = t->id;
+    }
+    fatia = t->restante <= s->quantum ? t->restante : s->quantum;
+    s->tempo_atual += fatia;
+    t->restante -= fatia;
+
+    if (t->restante > 0) {
+        return fila_inserir(&s->prontos, idx); // Volta ao fim da fila
+    }
+
+    // Terminou: alimenta as estatísticas, entrega o resultado e libera a entrada
+    ConclusaoFluxo c;
+    c.id = t->id;
+    c.chegada = t->chegada;
+    c.duracao = t->duracao;
+    c.inicio = t->inicio;
+    c.termino = s->tempo_atual;
+    c.retorno = c.termino - c.chegada;
+    c.espera = c.retorno - c.duracao;
+    hist_registrar(&s->hist_espera, c.espera);
+    hist_registrar(&s->hist_retorno, c.retorno);
+    s->concluidos++;
+    s->ultimo_id = 0;
+    if (s->rastro != NULL) RASTRAR(s->rastro, c.termino, c.id, RASTRO_TERMINO);
+    if (s->ao_concluir != NULL) s->ao_concluir(&c, s->contexto);
+    return fila_inserir(&s->livres, idx);
+}
+
+// Executa todas as fatias que começam antes do instante `ate`.
+// Retorna 0 ou -1 se faltar memória.
+static inline int fluxo_avancar(SimuladorFluxo *s, int ate) {
+    while (!fila_vazia(&s->prontos) && s->tempo_atual < ate) {
+        if (fluxo_executar_fatia(s) != 0) return -1;
+    }
+    return 0;
+}
+
+// Admite um processo que chega no instante `chegada`, depois de simular tudo o que
+// acontece antes dele. As chegadas devem vir em ordem de tempo (e, no mesmo instante,
+// na ordem em que devem entrar na fila). Retorna 0 ou -1 em caso de erro (mensagem em stderr).
+static inline int fluxo_chegada(SimuladorFluxo *s, int id, int chegada, int duracao) {
+    TarefaFluxo *t;
+    int idx;
+
+    if (chegada < s->ultima_chegada) {
+        fprintf(stderr, "Erro: O processo %d chega em %d, antes do anterior (%d); "
+                        "a simulação em fluxo exige chegadas em ordem de tempo.\n",
+                id, chegada, s->ultima_chegada);
+        return -1;
+    }
+    s->ultima_chegada = chegada;
+    if (fluxo_avancar(s, chegada) != 0) goto sem_memoria;
+    if (fila_vazia(&s->prontos) && s->tempo_atual < chegada) {
+        s->tempo_atual = chegada; // CPU ociosa até esta chegada
+    }
+
+    // Entrada para o processo: uma liberada por quem terminou ou uma nova
+    if (!fila_vazia(&s->livres)) {
+        idx = fila_remover(&s->livres);
+    } else {
+        if (s->usadas == s->capacidade) {
+            int nova_capacidade = s->capacidade == 0 ? FILA_CAPACIDADE_INICIAL : 2 * s->capacidade;
+            TarefaFluxo *novas = (TarefaFluxo *)realloc(s->tarefas, nova_capacidade * sizeof(TarefaFluxo));
+            if (novas == NULL) goto sem_memoria;
+            s->tarefas = novas;
+            s->capacidade = nova_capacidade;
+        }
+        idx = s->usadas++;
+    }
+    t = &s->tarefas[idx];
+    t->id = id;
+    t->chegada = chegada;
+    t->duracao = duracao;
+    t->restante = duracao;
+    t->inicio = -1;
+    if (fila_inserir(&s->prontos, idx) != 0) goto sem_memoria;
+    s->admitidos++;
+    if (fluxo_presentes(s) > s->maior_presenca) {
+        s->maior_presenca = fluxo_presentes(s);
+    }
+    if (s->rastro != NULL) RASTRAR(s->rastro, chegada, id, RASTRO_CHEGADA);
+    return 0;
+
+sem_memoria:
+    fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+    return -1;
+}
+
+// Sem mais chegadas: executa os processos restantes até o fim.
+// Retorna 0 ou -1 se faltar memória.
+static inline int fluxo_encerrar(SimuladorFluxo *s) {
+    if (fluxo_avancar(s, INT_MAX) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Alimenta o simulador com todos os processos de um arquivo de carga já aberto (IDs na
+// ordem do arquivo, a partir de 1), sem guardá-los: as páginas já lidas do arquivo são
+// devolvidas ao sistema a cada FLUXO_BLOCO_CARGA processos. Não chama fluxo_encerrar.
+// Retorna 0 ou -1 em caso de erro (mensagem em stderr).
+static inline int fluxo_alimentar(SimuladorFluxo *s, LeitorCarga *carga) {
+    int chegada, duracao, prioridade, r;
+    long id = 0;
+
+    while ((r = carga_proximo(carga, &chegada, &duracao, &prioridade)) == 1) {
+        if (fluxo_chegada(s, (int)++id, chegada, duracao) != 0) return -1;
+        if (id % FLUXO_BLOCO_CARGA == 0) {
+            carga_liberar_lidos(carga);
+        }
+    }
+    return r == 0 ? 0 : -1;
+}
+
+#endif // FLUXO_H
@@ -0,0 +1,138 @@
+/*
+ * Gerador de Cargas de Trabalho Sintéticas
+ * Este programa gera uma lista de processos com chegadas de Poisson, durações de
+ * cauda pesada (ou exponenciais) e prioridades configuráveis (ver gerador.h) e a
+ * grava em um dos formatos aceitos pela opção -e dos escalonadores (ver carga.h).
+ * A mesma semente gera sempre o mesmo arquivo. Os processos são gerados e gravados
+ * em blocos, então o uso de memória não depende da quantidade de processos.
+ *
+ * Compilação: gcc -O2 -o gerador gerador.c -lm
+ * Uso: ./gerador -n quantidade [-o arquivo] [-f csv|binario] [-s semente] [-u utilizacao]
+ *                [-d exponencial|pareto|lognormal] [-m duracao_media] [-a alfa] [-g sigma]
+ *                [-p uniforme|geometrica|fixa] [-k niveis]
+ *   -n: quantidade de processos
+ *   -o: arquivo de saída (padrão: saída padrão)
+ *   -f: formato do arquivo (padrão: binario)
+ *   -s: semente do gerador de números aleatórios (padrão: 1)
+ *   -u: utilização esperada da CPU, que define a taxa de chegada (padrão: 0.9)
+ *   -d: distribuição das durações (padrão: exponencial)
+ *   -m: duração média (padrão: 10)
+ *   -a: forma da Pareto, maior que 1 (padrão: 1.5)
+ *   -g: sigma da lognormal (padrão: 1.0)
+ *   -p: distribuição das prioridades (padrão: uniforme)
+ *   -k: quantidade de níveis de prioridade (padrão: 8)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>  // Para atol, atof, strtoull
+#include <string.h>  // Para strcmp, memcpy
+#include <unistd.h>  // Para getopt
+#include "carga.h"   // Formatos de arquivo de carga (CargaCabecalho, CargaRegistro)
+#include "gerador.h" // Distribuições e gerador de números aleatórios
+
+#define TAMANHO_BLOCO 65536 // Processos gerados por vez
+
+int main(int argc, char *argv[]) {
+    ParametrosGerador parametros;
+    GeradorCarga gerador;
+    static int chegada[TAMANHO_BLOCO], duracao[TAMANHO_BLOCO], prioridade[TAMANHO_BLOCO];
+    static char buffer[1 << 20];
+    const char *arquivo_saida = NULL;
+    FILE *saida = stdout;
+    long n = 0, gerados;
+    int binario = 1, opcao, i, status = 0;
+
+    gerador_parametros_padrao(&parametros);
+    while ((opcao = getopt(argc, argv, "n:o:f:s:u:d:m:a:g:p:k:")) != -1) {
+        switch (opcao) {
+        case 'n': n = atol(optarg); break;
+        case 'o': arquivo_saida = optarg; break;
+        case 'f':
+            if (strcmp(optarg, "csv") == 0) binario = 0;
+            else if (strcmp(optarg, "binario") == 0) binario = 1;
+            else {
+                fprintf(stderr, "Erro: Formato '%s' desconhecido (use csv ou binario).\n", optarg);
+                return 1;
+            }
+            break;
+        case 's': parametros.semente = strtoull(optarg, NULL, 10); break;
+        case 'u': parametros.utilizacao = atof(optarg); break;
+        case 'd':
+            if (gerador_distribuicao_duracao(optarg, &parametros.duracao) != 0) {
+                fprintf(stderr, "Erro: Distribuição '%s' desconhecida (use exponencial, pareto ou lognormal).\n", optarg);
+                return 1;
+            }
+            break;
+        case 'm': parametros.duracao_media = atof(optarg); break;
+        case 'a': parametros.alfa = atof(optarg); break;
+        case 'g': parametros.sigma = atof(optarg); break;
+        case 'p':
+            if (gerador_distribuicao_prioridade(optarg, &parametros.prioridade) != 0) {
+                fprintf(stderr, "Erro: Distribuição '%s' desconhecida (use uniforme, geometrica ou fixa).\n", optarg);
+                return 1;
+            }
+            break;
+        case 'k': parametros.niveis = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Uso: %s -n quantidade [-o arquivo] [-f csv|binario] [-s semente] [-u utilizacao]\n"
+                            "       [-d exponencial|pareto|lognormal] [-m duracao_media] [-a alfa] [-g sigma]\n"
+                            "       [-p uniforme|geometrica|fixa] [-k niveis]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (n <= 0 || n > INT_MAX) {
+        fprintf(stderr, "Erro: Informe a quantidade de processos com -n (inteiro positivo).\n");
+        return 1;
+    }
+    if (gerador_iniciar(&gerador, &parametros) != 0) {
+        return 1;
+    }
+
+    if (arquivo_saida != NULL) {
+        saida = fopen(arquivo_saida, binario ? "wb" : "w");
+        if (saida == NULL) {
+            fprintf(stderr, "Erro: Não foi possível criar o arquivo '%s'.\n", arquivo_saida);
+            return 1;
+        }
+    }
+    setvbuf(saida, buffer, _IOFBF, sizeof(buffer));
+
+    if (binario) {
+        CargaCabecalho cab;
+        memcpy(cab.magico, CARGA_MAGICO, 4);
+        cab.versao = CARGA_VERSAO;
+        cab.quantidade = (uint64_t)n;
+        fwrite(&cab, sizeof(cab), 1, saida);
+    } else {
+        fprintf(saida, "chegada,duracao,prioridade\n");
+    }
+
+    for (gerados = 0; gerados < n && status == 0; gerados += TAMANHO_BLOCO) {
+        int bloco = n - gerados < TAMANHO_BLOCO ? (int)(n - gerados) : TAMANHO_BLOCO;
+        if (gerador_gerar(&gerador, bloco, chegada, duracao, prioridade) != 0) {
+            status = 1;
+            break;
+        }
+        for (i = 0; i < bloco; i++) {
+            if (binario) {
+                CargaRegistro r;
+                r.chegada = chegada[i];
+                r.duracao = duracao[i];
+                r.prioridade = prioridade[i];
+                fwrite(&r, sizeof(r), 1, saida);
+            } else {
+                fprintf(saida, "%d,%d,%d\n", chegada[i], duracao[i], prioridade[i]);
+            }
+        }
+    }
+
+    if (ferror(saida) || (saida != stdout ? fclose(saida) : fflush(saida)) != 0) {
+        fprintf(stderr, "Erro: Falha ao gravar a carga gerada.\n");
+        status = 1;
+    }
+    if (status == 0 && arquivo_saida != NULL) {
+        fprintf(stderr, "%ld processos gravados em '%s' (último término possível: %lld).\n",
+                n, arquivo_saida, (long long)gerador.fim);
+    }
+    return status;
+}
@@ -0,0 +1,228 @@
+/*
+ * Geração de cargas de trabalho sintéticas e reprodutíveis.
+ * As chegadas seguem um processo de Poisson (intervalos exponenciais), as durações
+ * vêm de uma distribuição escolhida (exponencial, Pareto ou lognormal, as duas últimas
+ * de cauda pesada) e as prioridades de uma distribuição discreta configurável.
+ * O gerador de números aleatórios é o xoshiro256** semeado por splitmix64: a mesma
+ * semente produz sempre a mesma carga, em qualquer máquina.
+ *
+ * A taxa de chegada é derivada da utilização desejada da CPU: com duração média m e
+ * utilização u, o intervalo médio entre chegadas é m / u.
+ *
+ * Os processos são gerados em blocos, na ordem de chegada, para que cargas muito
+ * grandes possam ser gravadas em arquivo sem ficar inteiras na memória:
+ *     GeradorCarga g;
+ *     gerador_iniciar(&g, &parametros);
+ *     while (...) gerador_gerar(&g, bloco, chegada, duracao, prioridade);
+ *
+ * Uso: basta incluir este arquivo; as funções são `static inline`. Compile com -lm.
+ */
+
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include <stdio.h>   // Para fprintf
+#include <stdint.h>  // Para uint64_t, int64_t
+#include <string.h>  // Para strcmp
+#include <limits.h>  // Para INT_MAX
+#include <math.h>    // Para log, exp, pow, sqrt, cos
+
+#define GERADOR_DURACAO_MAXIMA 10000000 // Limite das durações (evita estouro nas caudas pesadas)
+
+typedef enum {
+    DURACAO_EXPONENCIAL,
+    DURACAO_PARETO,
+    DURACAO_LOGNORMAL
+} DistribuicaoDuracao;
+
+typedef enum {
+    PRIORIDADE_UNIFORME,    // Níveis 0 .. niveis-1 igualmente prováveis
+    PRIORIDADE_GEOMETRICA,  // Cada nível é metade tão provável quanto o anterior
+    PRIORIDADE_FIXA         // Todos os processos com prioridade 0
+} DistribuicaoPrioridade;
+
+typedef struct {
+    uint64_t semente;
+    double utilizacao;              // Fração esperada de ocupação da CPU (0 < u)
+    DistribuicaoDuracao duracao;
+    double duracao_media;           // Média da distribuição de durações
+    double alfa;                    // Forma da Pareto (> 1; menor = cauda mais pesada)
+    double sigma;                   // Desvio do logaritmo na lognormal
+    DistribuicaoPrioridade prioridade;
+    int niveis;                     // Quantidade de níveis de prioridade
+} ParametrosGerador;
+
+// Estado do xoshiro256**
+typedef struct {
+    uint64_t s[4];
+} Aleatorio;
+
+typedef struct {
+    ParametrosGerador p;
+    Aleatorio aleatorio;
+    double tempo;        // Instante da última chegada gerada
+    double escala;       // Parâmetro de escala da distribuição de durações
+    double intervalo;    // Intervalo médio entre chegadas
+    int64_t fim;         // Término do último processo em qualquer política que não deixa a CPU ociosa
+} GeradorCarga;
+
+static inline void gerador_parametros_padrao(ParametrosGerador *p) {
+    p->semente = 1;
+    p->utilizacao = 0.9;
+    p->duracao = DURACAO_EXPONENCIAL;
+    p->duracao_media = 10.0;
+    p->alfa = 1.5;
+    p->sigma = 1.0;
+    p->prioridade = PRIORIDADE_UNIFORME;
+    p->niveis = 8;
+}
+
+// Converte nomes de distribuição (opções de linha de comando). Retornam 0 ou -1 se desconhecido.
+static inline int gerador_distribuicao_duracao(const char *nome, DistribuicaoDuracao *d) {
+    if (strcmp(nome, "exponencial") == 0) *d = DURACAO_EXPONENCIAL;
+    else if (strcmp(nome, "pareto") == 0) *d = DURACAO_PARETO;
+    else if (strcmp(nome, "lognormal") == 0) *d = DURACAO_LOGNORMAL;
+    else return -1;
+    return 0;
+}
+
+static inline int gerador_distribuicao_prioridade(const char *nome, DistribuicaoPrioridade *d) {
+    if (strcmp(nome, "uniforme") == 0) *d = PRIORIDADE_UNIFORME;
+    else if (strcmp(nome, "geometrica") == 0) *d = PRIORIDADE_GEOMETRICA;
+    else if (strcmp(nome, "fixa") == 0) *d = PRIORIDADE_FIXA;
+    else return -1;
+    return 0;
+}
+
+// --- Números aleatórios ---
+
+static inline uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline void aleatorio_semear(Aleatorio *a, uint64_t semente) {
+    int k;
+    for (k = 0; k < 4; k++) {
+        a->s[k] = splitmix64(&semente);
+    }
+}
+
+static inline uint64_t rotacionar(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t aleatorio_proximo(Aleatorio *a) {
+    uint64_t *s = a->s;
+    uint64_t resultado = rotacionar(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotacionar(s[3], 45);
+    return resultado;
+}
+
+// Uniforme em (0, 1): nunca 0, para que log() seja sempre finito
+static inline double aleatorio_uniforme(Aleatorio *a) {
+    return ((aleatorio_proximo(a) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static inline double aleatorio_exponencial(Aleatorio *a, double media) {
+    return -media * log(aleatorio_uniforme(a));
+}
+
+// Normal padrão pelo método de Box-Muller (usa apenas um dos dois valores)
+static inline double aleatorio_normal(Aleatorio *a) {
+    double u1 = aleatorio_uniforme(a), u2 = aleatorio_uniforme(a);
+    return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+// --- Geração da carga ---
+
+// Prepara o gerador. Retorna 0 ou -1 (mensagem em stderr) se os parâmetros forem inválidos.
+static inline int gerador_iniciar(GeradorCarga *g, const ParametrosGerador *p) {
+    if (p->utilizacao <= 0 || p->duracao_media < 1 || p->niveis <= 0 ||
+        (p->duracao == DURACAO_PARETO && p->alfa <= 1) ||
+        (p->duracao == DURACAO_LOGNORMAL && p->sigma < 0)) {
+        fprintf(stderr, "Erro: Parâmetros do gerador inválidos (utilização > 0, duração média >= 1, "
+                        "alfa > 1, sigma >= 0, níveis > 0).\n");
+        return -1;
+    }
+    g->p = *p;
+    aleatorio_semear(&g->aleatorio, p->semente);
+    g->tempo = 0;
+    g->fim = 0;
+    g->intervalo = p->duracao_media / p->utilizacao;
+    switch (p->duracao) {
+    case DURACAO_EXPONENCIAL:
+        g->escala = p->duracao_media;
+        break;
+    case DURACAO_PARETO: // Média = escala * alfa / (alfa - 1)
+        g->escala = p->duracao_media * (p->alfa - 1) / p->alfa;
+        break;
+    case DURACAO_LOGNORMAL: // Média = exp(mu + sigma^2 / 2)
+        g->escala = log(p->duracao_media) - p->sigma * p->sigma / 2;
+        break;
+    }
+    return 0;
+}
+
+static inline int gerador_duracao(GeradorCarga *g) {
+    double d = 0;
+    switch (g->p.duracao) {
+    case DURACAO_EXPONENCIAL:
+        d = aleatorio_exponencial(&g->aleatorio, g->escala);
+        break;
+    case DURACAO_PARETO:
+        d = g->escala / pow(aleatorio_uniforme(&g->aleatorio), 1.0 / g->p.alfa);
+        break;
+    case DURACAO_LOGNORMAL:
+        d = exp(g->escala + g->p.sigma * aleatorio_normal(&g->aleatorio));
+        break;
+    }
+    if (d < 1) return 1; // Todo processo precisa de pelo menos uma unidade de CPU
+    if (d > GERADOR_DURACAO_MAXIMA) return GERADOR_DURACAO_MAXIMA;
+    return (int)(d + 0.5);
+}
+
+static inline int gerador_prioridade(GeradorCarga *g) {
+    int nivel = 0;
+    switch (g->p.prioridade) {
+    case PRIORIDADE_UNIFORME:
+        return (int)(aleatorio_proximo(&g->aleatorio) % (uint64_t)g->p.niveis);
+    case PRIORIDADE_GEOMETRICA:
+        while (nivel < g->p.niveis - 1 && (aleatorio_proximo(&g->aleatorio) >> 63)) nivel++;
+        return nivel;
+    case PRIORIDADE_FIXA:
+        break;
+    }
+    return 0;
+}
+
+// Gera os próximos `quantidade` processos, em ordem de chegada.
+// Retorna 0 ou -1 se o término da carga ultrapassar o limite de tempo (int) dos simuladores.
+static inline int gerador_gerar(GeradorCarga *g, int quantidade, int *chegada, int *duracao, int *prioridade) {
+    int i;
+    for (i = 0; i < quantidade; i++) {
+        g->tempo += aleatorio_exponencial(&g->aleatorio, g->intervalo);
+        chegada[i] = g->tempo < INT_MAX ? (int)g->tempo : INT_MAX;
+        duracao[i] = gerador_duracao(g);
+        prioridade[i] = gerador_prioridade(g);
+        // O instante em que a CPU esvazia é o mesmo para todas as políticas (FCFS, SJF,
+        // Round Robin, Prioridade), então basta acompanhá-lo na ordem de chegada
+        g->fim = (g->fim > chegada[i] ? g->fim : chegada[i]) + duracao[i];
+        if (g->fim > INT_MAX) {
+            fprintf(stderr, "Erro: A carga gerada ultrapassa o limite de tempo da simulação "
+                            "(reduza a quantidade de processos ou a duração média).\n");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+#endif // GERADOR_H
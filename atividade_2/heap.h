@@ -0,0 +1,242 @@
+/*
+ * Heap binário indexado (min-heap) de índices de processos.
+ * Cada elemento do heap é o índice de um processo no vetor do simulador; a ordem é
+ * definida por uma função de comparação fornecida pelo usuário (por exemplo,
+ * duração -> chegada -> ID no SJF ou prioridade -> chegada -> ID no escalonamento
+ * por prioridade). O vetor `posicao` guarda onde cada índice está no heap, o que
+ * permite remover ou reposicionar um processo qualquer em O(log n).
+ *
+ * Operações:
+ * - heap_inserir, heap_remover_topo, heap_remover, heap_atualizar: O(log n)
+ * - heap_topo, heap_vazio, heap_contem: O(1)
+ * - heap_restaurar: O(k), recoloca k itens salvos (por exemplo, de um checkpoint)
+ *
+ * Vários heaps podem compartilhar um único vetor `posicao` (heap_criar_compartilhado)
+ * quando cada processo está em no máximo um deles por vez, como nas filas de prontos
+ * por CPU do simulador multiprocessador; nesse caso `itens` começa pequeno e cresce
+ * com heap_reservar, e heap_contem indica se o processo está em algum dos heaps.
+ *
+ * As operações que comparam existem também na forma *_com, que recebe o comparador
+ * como argumento. HEAP_ESPECIALIZAR(sufixo, comparador) gera a partir delas
+ * heap_inserir_<sufixo>, heap_remover_<sufixo>, heap_remover_topo_<sufixo> e
+ * heap_atualizar_<sufixo>, nas quais o comparador é conhecido em tempo de compilação e
+ * é expandido no corpo de heap_subir_com/heap_descer_com, sem a chamada indireta por
+ * `h->comparar` a cada comparação. As duas formas podem ser misturadas no mesmo heap,
+ * desde que o comparador seja o mesmo passado a heap_criar.
+ *
+ * Uso: basta incluir este arquivo; todas as funções são `static`, então cada
+ * programa continua sendo compilado com um único `gcc -o prog prog.c`.
+ */
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stdlib.h> // Para malloc, free
+
+// Compara os processos de índices a e b. Retorna < 0 se a deve sair antes de b,
+// > 0 se b deve sair antes de a e 0 se forem equivalentes.
+typedef int (*HeapComparador)(int a, int b, const void *contexto);
+
+typedef struct {
+    int *itens;             // Índices dos processos organizados como heap binário
+    int *posicao;           // posicao[idx] = posição de idx em itens, ou -1 se ausente
+    int tamanho;            // Quantidade de elementos atualmente no heap
+    int capacidade;         // Maior índice de processo aceito + 1
+    int alocados;           // Posições alocadas em `itens`
+    int posicao_propria;    // 1 se `posicao` pertence a este heap (e é liberado por ele)
+    HeapComparador comparar;
+    const void *contexto;   // Repassado ao comparador (normalmente o vetor de processos)
+} HeapIndexado;
+
+// Aloca um heap capaz de conter os índices 0..capacidade-1. Retorna 0 em caso de
+// sucesso e -1 se a alocação falhar.
+static inline int heap_criar(HeapIndexado *h, int capacidade, HeapComparador comparar, const void *contexto) {
+    int i;
+    h->itens = (int *)malloc((capacidade > 0 ? capacidade : 1) * sizeof(int));
+    h->posicao = (int *)malloc((capacidade > 0 ? capacidade : 1) * sizeof(int));
+    if (h->itens == NULL || h->posicao == NULL) {
+        free(h->itens);
+        free(h->posicao);
+        h->itens = h->posicao = NULL;
+        return -1;
+    }
+    for (i = 0; i < capacidade; i++) {
+        h->posicao[i] = -1;
+    }
+    h->tamanho = 0;
+    h->capacidade = capacidade;
+    h->alocados = capacidade > 0 ? capacidade : 1;
+    h->posicao_propria = 1;
+    h->comparar = comparar;
+    h->contexto = contexto;
+    return 0;
+}
+
+// Cria um heap vazio que usa o vetor `posicao` (com `capacidade` posições, todas -1)
+// compartilhado com outros heaps. Antes de cada heap_inserir é preciso chamar
+// heap_reservar. Retorna 0 em caso de sucesso e -1 se a alocação falhar.
+static inline int heap_criar_compartilhado(HeapIndexado *h, int *posicao, int capacidade,
+                                           HeapComparador comparar, const void *contexto) {
+    h->alocados = 16;
+    h->itens = (int *)malloc(h->alocados * sizeof(int));
+    h->posicao = posicao;
+    h->posicao_propria = 0;
+    h->tamanho = 0;
+    h->capacidade = capacidade;
+    h->comparar = comparar;
+    h->contexto = contexto;
+    return h->itens != NULL ? 0 : -1;
+}
+
+// Garante espaço em `itens` para mais um elemento, dobrando o vetor se necessário.
+// Retorna 0 em caso de sucesso e -1 se a alocação falhar.
+static inline int heap_reservar(HeapIndexado *h) {
+    int *novos;
+    if (h->tamanho < h->alocados) return 0;
+    novos = (int *)realloc(h->itens, 2 * (size_t)h->alocados * sizeof(int));
+    if (novos == NULL) return -1;
+    h->itens = novos;
+    h->alocados *= 2;
+    return 0;
+}
+
+static inline void heap_destruir(HeapIndexado *h) {
+    free(h->itens);
+    if (h->posicao_propria) {
+        free(h->posicao);
+    }
+    h->itens = h->posicao = NULL;
+    h->tamanho = h->capacidade = h->alocados = 0;
+}
+
+static inline int heap_vazio(const HeapIndexado *h) {
+    return h->tamanho == 0;
+}
+
+// Índice do processo no topo (menor segundo o comparador), ou -1 se vazio
+static inline int heap_topo(const HeapIndexado *h) {
+    return h->tamanho > 0 ? h->itens[0] : -1;
+}
+
+static inline int heap_contem(const HeapIndexado *h, int idx) {
+    return h->posicao[idx] != -1;
+}
+
+// Coloca idx na posição pos do vetor, mantendo `posicao` consistente
+static inline void heap_colocar(HeapIndexado *h, int pos, int idx) {
+    h->itens[pos] = idx;
+    h->posicao[idx] = pos;
+}
+
+// Sobe o elemento da posição pos enquanto for menor que o pai
+static inline void heap_subir_com(HeapIndexado *h, int pos, HeapComparador comparar) {
+    int idx = h->itens[pos];
+    while (pos > 0) {
+        int pai = (pos - 1) / 2;
+        if (comparar(idx, h->itens[pai], h->contexto) >= 0) break;
+        heap_colocar(h, pos, h->itens[pai]);
+        pos = pai;
+    }
+    heap_colocar(h, pos, idx);
+}
+
+// Desce o elemento da posição pos enquanto algum filho for menor que ele
+static inline void heap_descer_com(HeapIndexado *h, int pos, HeapComparador comparar) {
+    int idx = h->itens[pos];
+    for (;;) {
+        int filho = 2 * pos + 1;
+        if (filho >= h->tamanho) break;
+        if (filho + 1 < h->tamanho && comparar(h->itens[filho + 1], h->itens[filho], h->contexto) < 0) {
+            filho++;
+        }
+        if (comparar(h->itens[filho], idx, h->contexto) >= 0) break;
+        heap_colocar(h, pos, h->itens[filho]);
+        pos = filho;
+    }
+    heap_colocar(h, pos, idx);
+}
+
+// Insere o processo idx (que não pode já estar no heap)
+static inline void heap_inserir_com(HeapIndexado *h, int idx, HeapComparador comparar) {
+    h->itens[h->tamanho] = idx;
+    h->posicao[idx] = h->tamanho;
+    h->tamanho++;
+    heap_subir_com(h, h->tamanho - 1, comparar);
+}
+
+// Remove o processo idx, esteja ele em qualquer posição do heap
+static inline void heap_remover_com(HeapIndexado *h, int idx, HeapComparador comparar) {
+    int pos = h->posicao[idx];
+    int ultimo;
+    if (pos == -1) return;
+    h->posicao[idx] = -1;
+    h->tamanho--;
+    if (pos == h->tamanho) return; // Era o último elemento
+    ultimo = h->itens[h->tamanho];
+    heap_colocar(h, pos, ultimo);
+    heap_subir_com(h, pos, comparar);
+    heap_descer_com(h, h->posicao[ultimo], comparar);
+}
+
+// Remove e retorna o processo do topo, ou -1 se o heap estiver vazio
+static inline int heap_remover_topo_com(HeapIndexado *h, HeapComparador comparar) {
+    int topo = heap_topo(h);
+    if (topo != -1) {
+        heap_remover_com(h, topo, comparar);
+    }
+    return topo;
+}
+
+// Reposiciona idx após uma mudança na sua chave de ordenação
+static inline void heap_atualizar_com(HeapIndexado *h, int idx, HeapComparador comparar) {
+    int pos = h->posicao[idx];
+    if (pos == -1) return;
+    heap_subir_com(h, pos, comparar);
+    heap_descer_com(h, h->posicao[idx], comparar);
+}
+
+// Formas genéricas: usam o comparador guardado por heap_criar
+static inline void heap_inserir(HeapIndexado *h, int idx) {
+    heap_inserir_com(h, idx, h->comparar);
+}
+
+static inline void heap_remover(HeapIndexado *h, int idx) {
+    heap_remover_com(h, idx, h->comparar);
+}
+
+static inline int heap_remover_topo(HeapIndexado *h) {
+    return heap_remover_topo_com(h, h->comparar);
+}
+
+static inline void heap_atualizar(HeapIndexado *h, int idx) {
+    heap_atualizar_com(h, idx, h->comparar);
+}
+
+// Formas especializadas para um comparador fixo (ver comentário do topo)
+#define HEAP_ESPECIALIZAR(sufixo, comparador)                                             \
+    static inline void heap_inserir_##sufixo(HeapIndexado *h, int idx) {                \
+        heap_inserir_com(h, idx, comparador);                                             \
+    }                                                                                     \
+    static inline void heap_remover_##sufixo(HeapIndexado *h, int idx) {                \
+        heap_remover_com(h, idx, comparador);                                             \
+    }                                                                                     \
+    static inline int heap_remover_topo_##sufixo(HeapIndexado *h) {                     \
+        return heap_remover_topo_com(h, comparador);                                      \
+    }                                                                                     \
+    static inline void heap_atualizar_##sufixo(HeapIndexado *h, int idx) {              \
+        heap_atualizar_com(h, idx, comparador);                                           \
+    }
+
+// Substitui o conteúdo do heap (vazio, de capacidade própria) pelos `quantidade` itens
+// em exatamente a ordem dada, que deve ser uma cópia de `itens` de um heap válido com o
+// mesmo comparador. Usado ao retomar um checkpoint: a disposição interna fica idêntica
+// à original, e com ela todas as escolhas seguintes.
+static inline void heap_restaurar(HeapIndexado *h, const int *itens, int quantidade) {
+    int pos;
+    h->tamanho = quantidade;
+    for (pos = 0; pos < quantidade; pos++) {
+        heap_colocar(h, pos, itens[pos]);
+    }
+}
+
+#endif // HEAP_H
@@ -0,0 +1,108 @@
+/*
+ * Histograma log-linear de latências (no estilo do HdrHistogram).
+ * Cada valor registrado incrementa um único contador, então a memória é fixa
+ * (HIST_BUCKETS contadores) qualquer que seja o número de processos, e os percentis
+ * saem de uma varredura dos contadores, sem ordenar os valores.
+ *
+ * Organização dos baldes: valores menores que HIST_SUB (128) têm um balde cada
+ * (exatos). Acima disso, cada potência de 2 é dividida em HIST_SUB / 2 baldes de
+ * mesma largura, o que limita o erro relativo de um percentil a 1/64 (~1,6%).
+ * A soma, o mínimo e o máximo são mantidos à parte e são exatos.
+ *
+ * Uso: basta incluir este arquivo; as funções são `static inline`.
+ */
+
+#ifndef HISTOGRAMA_H
+#define HISTOGRAMA_H
+
+#include <stdio.h>  // Para printf
+#include <stdint.h> // Para int64_t, uint64_t
+#include <string.h> // Para memset
+
+#define HIST_BITS 7                      // Bits de precisão de cada balde
+#define HIST_SUB (1 << HIST_BITS)        // Baldes exatos para valores pequenos (128)
+#define HIST_METADE (HIST_SUB / 2)       // Baldes por potência de 2 acima de HIST_SUB
+#define HIST_BUCKETS (HIST_SUB + (63 - HIST_BITS) * HIST_METADE)
+
+typedef struct {
+    uint64_t contagem[HIST_BUCKETS];
+    uint64_t total;   // Quantidade de valores registrados
+    int64_t soma;     // Soma exata dos valores (para a média)
+    int64_t minimo;
+    int64_t maximo;
+} Histograma;
+
+static inline void hist_iniciar(Histograma *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+// Balde de um valor (valores negativos são tratados como 0)
+static inline int hist_balde(int64_t valor) {
+    int msb, deslocamento;
+    if (valor < HIST_SUB) return valor < 0 ? 0 : (int)valor;
+    msb = 63 - __builtin_clzll((unsigned long long)valor);
+    deslocamento = msb - HIST_BITS + 1; // Bits descartados: a mantissa fica em [64, 128)
+    return HIST_SUB + (deslocamento - 1) * HIST_METADE + (int)(valor >> deslocamento) - HIST_METADE;
+}
+
+// Maior valor que cai no balde b
+static inline int64_t hist_limite_superior(int b) {
+    int deslocamento, mantissa;
+    if (b < HIST_SUB) return b;
+    deslocamento = (b - HIST_SUB) / HIST_METADE + 1;
+    mantissa = (b - HIST_SUB) % HIST_METADE + HIST_METADE;
+    return ((int64_t)(mantissa + 1) << deslocamento) - 1;
+}
+
+static inline void hist_registrar(Histograma *h, int64_t valor) {
+    if (h->total == 0 || valor < h->minimo) h->minimo = valor;
+    if (h->total == 0 || valor > h->maximo) h->maximo = valor;
+    h->contagem[hist_balde(valor)]++;
+    h->total++;
+    h->soma += valor;
+}
+
+// Acumula os valores de `origem` em `destino` (por exemplo, histogramas de threads diferentes)
+static inline void hist_mesclar(Histograma *destino, const Histograma *origem) {
+    int b;
+    if (origem->total == 0) return;
+    for (b = 0; b < HIST_BUCKETS; b++) {
+        destino->contagem[b] += origem->contagem[b];
+    }
+    if (destino->total == 0 || origem->minimo < destino->minimo) destino->minimo = origem->minimo;
+    if (destino->total == 0 || origem->maximo > destino->maximo) destino->maximo = origem->maximo;
+    destino->total += origem->total;
+    destino->soma += origem->soma;
+}
+
+static inline double hist_media(const Histograma *h) {
+    return h->total > 0 ? (double)h->soma / h->total : 0.0;
+}
+
+// Valor abaixo do qual (ou igual) estão `percentil`% dos registros, como o maior
+// valor equivalente do balde correspondente (nunca acima do máximo real)
+static inline int64_t hist_percentil(const Histograma *h, double percentil) {
+    uint64_t alvo, acumulado = 0;
+    int b;
+    if (h->total == 0) return 0;
+    alvo = (uint64_t)(percentil / 100.0 * h->total + 0.5);
+    if (alvo < 1) alvo = 1;
+    if (alvo > h->total) alvo = h->total;
+    for (b = 0; b < HIST_BUCKETS; b++) {
+        acumulado += h->contagem[b];
+        if (acumulado >= alvo) {
+            int64_t limite = hist_limite_superior(b);
+            return limite < h->maximo ? limite : h->maximo;
+        }
+    }
+    return h->maximo;
+}
+
+// Exibe uma linha com os percentis 50, 90 e 99 e o máximo
+static inline void hist_exibir_percentis(const char *rotulo, const Histograma *h) {
+    printf("Percentis de %s: p50 = %lld | p90 = %lld | p99 = %lld | máx = %lld\n", rotulo,
+           (long long)hist_percentil(h, 50.0), (long long)hist_percentil(h, 90.0),
+           (long long)hist_percentil(h, 99.0), (long long)h->maximo);
+}
+
+#endif // HISTOGRAMA_H
@@ -0,0 +1,54 @@
+/*
+ * Kernels de cálculo de métricas sobre colunas de processos (structure of arrays).
+ * Depois que o escalonamento é conhecido (término de cada processo), espera e retorno
+ * de todos os processos e seus totais saem de um único laço sem desvios sobre vetores
+ * contíguos. Com `restrict` o compilador sabe que as colunas não se sobrepõem e pode
+ * vetorizar o laço (SIMD) com -O2/-O3; as somas são acumuladas em 64 bits, então não
+ * há perda de precisão nem estouro mesmo com centenas de milhões de processos.
+ *
+ * Uso: basta incluir este arquivo; as funções são `static inline`.
+ */
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stdint.h> // Para int64_t
+
+typedef struct {
+    int64_t soma_espera;
+    int64_t soma_retorno;
+    int maior_espera;
+    int maior_termino;
+} TotaisMetricas;
+
+// Calcula retorno[i] = termino[i] - chegada[i] e espera[i] = retorno[i] - duracao[i]
+// para os n processos, devolvendo as somas e os máximos.
+static inline TotaisMetricas metricas_calcular(long n,
+                                               const int *restrict chegada,
+                                               const int *restrict duracao,
+                                               const int *restrict termino,
+                                               int *restrict espera,
+                                               int *restrict retorno) {
+    TotaisMetricas t;
+    int64_t soma_espera = 0, soma_retorno = 0;
+    int maior_espera = 0, maior_termino = 0;
+    long i;
+
+    for (i = 0; i < n; i++) {
+        int r = termino[i] - chegada[i];
+        int e = r - duracao[i];
+        retorno[i] = r;
+        espera[i] = e;
+        soma_retorno += r;
+        soma_espera += e;
+        maior_espera = e > maior_espera ? e : maior_espera;
+        maior_termino = termino[i] > maior_termino ? termino[i] : maior_termino;
+    }
+    t.soma_espera = soma_espera;
+    t.soma_retorno = soma_retorno;
+    t.maior_espera = maior_espera;
+    t.maior_termino = maior_termino;
+    return t;
+}
+
+#endif // METRICAS_H
@@ -0,0 +1,468 @@
+/*
+ * Motor de simulação de escalonamento compartilhado (ver motor.h).
+ * Cada política recebe a carga somente para leitura, mantém seu estado mutável
+ * (tempo restante, filas) em memória própria e escreve apenas no seu Resultado.
+ * As políticas preenchem início e término de cada processo; espera, retorno e os
+ * totais são calculados depois, de uma só vez, pelos kernels de metricas.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>          // Para clock_gettime
+#include "motor.h"
+#include "metricas.h"      // Cálculo vetorizável de espera, retorno e totais
+#include "heap.h"          // Fila de prontos do SJF e da Prioridade
+#include "fila_circular.h" // Fila de prontos do Round Robin
+#include "carga.h"         // Leitura da carga a partir de arquivo
+#include "ordenacao.h"     // Radix sort das chegadas
+
+// Ordena índices de processos pela coluna de chegada; o radix sort é estável, então o
+// empate fica com o menor índice (= ID - 1)
+#define CHAVE_COLUNA(idx, chegada) ((chegada)[idx])
+ORDENACAO_RADIX(ordenar_por_chegada, int, const int *, CHAVE_COLUNA)
+
+// Ordem do SJF: menor duração, depois menor chegada, depois menor ID
+static int comparar_duracao(int a, int b, const void *contexto) {
+    const CargaTrabalho *c = (const CargaTrabalho *)contexto;
+    if (c->duracao[a] != c->duracao[b]) return c->duracao[a] < c->duracao[b] ? -1 : 1;
+    if (c->chegada[a] != c->chegada[b]) return c->chegada[a] < c->chegada[b] ? -1 : 1;
+    return a - b;
+}
+
+// Estado do SRTF consultado por comparar_restante: a carga e o tempo restante de cada processo
+typedef struct {
+    const CargaTrabalho *carga;
+    const int *restante;
+} ContextoSrtf;
+
+// Ordem do SRTF: menor tempo restante, depois menor chegada, depois menor ID
+static int comparar_restante(int a, int b, const void *contexto) {
+    const ContextoSrtf *c = (const ContextoSrtf *)contexto;
+    if (c->restante[a] != c->restante[b]) return c->restante[a] < c->restante[b] ? -1 : 1;
+    if (c->carga->chegada[a] != c->carga->chegada[b]) return c->carga->chegada[a] < c->carga->chegada[b] ? -1 : 1;
+    return a - b;
+}
+
+// Ordem da Prioridade: menor valor de prioridade, depois menor chegada, depois menor ID
+static int comparar_prioridade(int a, int b, const void *contexto) {
+    const CargaTrabalho *c = (const CargaTrabalho *)contexto;
+    if (c->prioridade[a] != c->prioridade[b]) return c->prioridade[a] < c->prioridade[b] ? -1 : 1;
+    if (c->chegada[a] != c->chegada[b]) return c->chegada[a] < c->chegada[b] ? -1 : 1;
+    return a - b;
+}
+
+// Operações do heap com o comparador expandido em tempo de compilação (heap.h)
+HEAP_ESPECIALIZAR(duracao, comparar_duracao)
+HEAP_ESPECIALIZAR(restante, comparar_restante)
+HEAP_ESPECIALIZAR(prioridade, comparar_prioridade)
+
+// --- Leitura da carga ---
+
+int motor_alocar_carga(CargaTrabalho *carga, int n) {
+    carga->n = n;
+    carga->chegada = (int *)malloc(n * sizeof(int));
+    carga->duracao = (int *)malloc(n * sizeof(int));
+    carga->prioridade = (int *)malloc(n * sizeof(int));
+    carga->ordem_chegada = (int *)malloc(n * sizeof(int));
+    if (carga->chegada == NULL || carga->duracao == NULL ||
+        carga->prioridade == NULL || carga->ordem_chegada == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
+        motor_liberar_carga(carga);
+        return -1;
+    }
+    return 0;
+}
+
+// Lê os processos pelo terminal (modo interativo)
+static int ler_carga_terminal(CargaTrabalho *carga) {
+    int i, n;
+
+    printf("Informe o número de processos: ");
+    if (scanf("%d", &n) != 1 || n <= 0) {
+        fprintf(stderr, "Erro: Número de processos deve ser um inteiro positivo.\n");
+        return -1;
+    }
+    if (motor_alocar_carga(carga, n) != 0) return -1;
+    printf("\n--- Entrada dos Dados dos Processos ---\n");
+    for (i = 0; i < n; i++) {
+        printf("Processo %d:\n", i + 1);
+        printf("  Tempo de chegada: ");
+        if (scanf("%d", &carga->chegada[i]) != 1 || carga->chegada[i] < 0) {
+            fprintf(stderr, "Erro: Tempo de chegada inválido para o processo %d (deve ser >= 0).\n", i + 1);
+            motor_liberar_carga(carga);
+            return -1;
+        }
+        printf("  Duração (burst): ");
+        if (scanf("%d", &carga->duracao[i]) != 1 || carga->duracao[i] <= 0) {
+            fprintf(stderr, "Erro: Duração inválida para o processo %d (deve ser > 0).\n", i + 1);
+            motor_liberar_carga(carga);
+            return -1;
+        }
+        printf("  Prioridade: ");
+        if (scanf("%d", &carga->prioridade[i]) != 1 || carga->prioridade[i] < 0) {
+            fprintf(stderr, "Erro: Prioridade inválida para o processo %d (deve ser >= 0).\n", i + 1);
+            motor_liberar_carga(carga);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Lê os processos de um arquivo de carga em uma única passada, direto para as colunas
+static int ler_carga_arquivo(CargaTrabalho *carga, const char *caminho) {
+    LeitorCarga leitor;
+    int i, n;
+
+    if (carga_abrir(&leitor, caminho) != 0) return -1;
+    n = (int)carga_quantidade(&leitor);
+    if (n <= 0) {
+        fprintf(stderr, "Erro: O arquivo '%s' não contém processos.\n", caminho);
+        carga_fechar(&leitor);
+        return -1;
+    }
+    if (motor_alocar_carga(carga, n) != 0) {
+        carga_fechar(&leitor);
+        return -1;
+    }
+    for (i = 0; i < n; i++) {
+        if (carga_proximo(&leitor, &carga->chegada[i], &carga->duracao[i], &carga->prioridade[i]) != 1) {
+            motor_liberar_carga(carga);
+            carga_fechar(&leitor);
+            return -1;
+        }
+    }
+    carga_fechar(&leitor);
+    return 0;
+}
+
+int motor_carregar(CargaTrabalho *carga, const char *caminho) {
+    carga->chegada = carga->duracao = carga->prioridade = carga->ordem_chegada = NULL;
+    if ((caminho != NULL ? ler_carga_arquivo(carga, caminho) : ler_carga_terminal(carga)) != 0) {
+        return -1;
+    }
+    if (motor_indexar_chegadas(carga) != 0) {
+        motor_liberar_carga(carga);
+        return -1;
+    }
+    return 0;
+}
+
+int motor_indexar_chegadas(CargaTrabalho *carga) {
+    int i;
+
+    // A ordem de chegada é calculada uma vez e compartilhada por todas as políticas
+    for (i = 0; i < carga->n; i++) {
+        carga->ordem_chegada[i] = i;
+    }
+    if (ordenar_por_chegada(carga->ordem_chegada, carga->n, carga->chegada) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a ordem de chegada!\n");
+        return -1;
+    }
+    return 0;
+}
+
+void motor_liberar_carga(CargaTrabalho *carga) {
+    free(carga->chegada);
+    free(carga->duracao);
+    free(carga->prioridade);
+    free(carga->ordem_chegada);
+    carga->chegada = carga->duracao = carga->prioridade = carga->ordem_chegada = NULL;
+    carga->n = 0;
+}
+
+// --- Políticas ---
+
+// FCFS: executa os processos na ordem de chegada, cada um até o fim
+static int simular_fcfs(const CargaTrabalho *carga, int parametro, Resultado *res) {
+    const int *chegada = carga->chegada, *duracao = carga->duracao;
+    int tempo_atual = 0;
+    int k;
+    (void)parametro;
+
+    for (k = 0; k < carga->n; k++) {
+        int i = carga->ordem_chegada[k];
+        if (tempo_atual < chegada[i]) {
+            tempo_atual = chegada[i]; // CPU ociosa até a chegada
+        }
+        res->inicio[i] = tempo_atual;
+        tempo_atual += duracao[i];
+        res->termino[i] = tempo_atual;
+        res->trocas_contexto++;
+        res->decisoes++;
+    }
+    return 0;
+}
+
+// SJF não preemptivo: entre os prontos, executa até o fim o de menor duração
+static int simular_sjf(const CargaTrabalho *carga, int parametro, Resultado *res) {
+    const int *chegada = carga->chegada, *duracao = carga->duracao;
+    HeapIndexado prontos;
+    int tempo_atual = 0, proxima_chegada = 0, finalizados = 0;
+    (void)parametro;
+
+    if (heap_criar(&prontos, carga->n, comparar_duracao, carga) != 0) return -1;
+    while (finalizados < carga->n) {
+        int i;
+        while (proxima_chegada < carga->n && chegada[carga->ordem_chegada[proxima_chegada]] <= tempo_atual) {
+            heap_inserir_duracao(&prontos, carga->ordem_chegada[proxima_chegada++]);
+        }
+        i = heap_remover_topo_duracao(&prontos);
+        if (i == -1) { // CPU ociosa: salta para a próxima chegada
+            tempo_atual = chegada[carga->ordem_chegada[proxima_chegada]];
+            continue;
+        }
+        res->inicio[i] = tempo_atual;
+        tempo_atual += duracao[i];
+        res->termino[i] = tempo_atual;
+        res->trocas_contexto++;
+        res->decisoes++;
+        finalizados++;
+    }
+    heap_destruir(&prontos);
+    return 0;
+}
+
+// SRTF (SJF preemptivo): o processo pronto com menor tempo restante executa até terminar
+// ou até a próxima chegada, quando a escolha é refeita
+static int simular_srtf(const CargaTrabalho *carga, int parametro, Resultado *res) {
+    const int *chegada = carga->chegada, *duracao = carga->duracao;
+    HeapIndexado prontos;
+    ContextoSrtf contexto;
+    int *restante;
+    int tempo_atual = 0, proxima_chegada = 0, finalizados = 0, ultimo = -1;
+    int i;
+    (void)parametro;
+
+    restante = (int *)malloc(carga->n * sizeof(int));
+    contexto.carga = carga;
+    contexto.restante = restante;
+    if (restante == NULL || heap_criar(&prontos, carga->n, comparar_restante, &contexto) != 0) {
+        free(restante);
+        return -1;
+    }
+    for (i = 0; i < carga->n; i++) {
+        restante[i] = duracao[i];
+        res->inicio[i] = -1;
+    }
+
+    while (finalizados < carga->n) {
+        int proximo_evento;
+        while (proxima_chegada < carga->n && chegada[carga->ordem_chegada[proxima_chegada]] <= tempo_atual) {
+            heap_inserir_restante(&prontos, carga->ordem_chegada[proxima_chegada++]);
+        }
+        i = heap_topo(&prontos);
+        if (i == -1) { // CPU ociosa: salta para a próxima chegada
+            tempo_atual = chegada[carga->ordem_chegada[proxima_chegada]];
+            ultimo = -1;
+            continue;
+        }
+        res->decisoes++;
+        if (res->inicio[i] == -1) {
+            res->inicio[i] = tempo_atual;
+        }
+        if (i != ultimo) {
+            res->trocas_contexto++;
+            ultimo = i;
+        }
+        proximo_evento = tempo_atual + restante[i];
+        if (proxima_chegada < carga->n && chegada[carga->ordem_chegada[proxima_chegada]] < proximo_evento) {
+            proximo_evento = chegada[carga->ordem_chegada[proxima_chegada]];
+        }
+        restante[i] -= proximo_evento - tempo_atual;
+        tempo_atual = proximo_evento;
+        if (restante[i] == 0) {
+            res->termino[i] = tempo_atual;
+            heap_remover_restante(&prontos, i);
+            finalizados++;
+            ultimo = -1;
+        } else {
+            heap_atualizar_restante(&prontos, i); // O tempo restante diminuiu
+        }
+    }
+    heap_destruir(&prontos);
+    free(restante);
+    return 0;
+}
+
+// Round Robin: fila circular de prontos, cada processo executa no máximo `quantum`
+// por vez. Os processos que chegam durante uma fatia entram na fila depois do
+// processo preemptado, como em round_robin.c.
+static int simular_rr(const CargaTrabalho *carga, int quantum, Resultado *res) {
+    const int *chegada = carga->chegada, *duracao = carga->duracao;
+    FilaCircular prontos;
+    int *restante;
+    int tempo_atual = 0, proxima_chegada = 0, finalizados = 0, ultimo = -1;
+    int i;
+
+    restante = (int *)malloc(carga->n * sizeof(int));
+    if (restante == NULL || fila_criar(&prontos) != 0) {
+        free(restante);
+        return -1;
+    }
+    for (i = 0; i < carga->n; i++) {
+        restante[i] = duracao[i];
+        res->inicio[i] = -1;
+    }
+
+    while (finalizados < carga->n) {
+        int fatia;
+        while (proxima_chegada < carga->n && chegada[carga->ordem_chegada[proxima_chegada]] <= tempo_atual) {
+            if (fila_inserir(&prontos, carga->ordem_chegada[proxima_chegada++]) != 0) goto sem_memoria;
+        }
+        if (fila_vazia(&prontos)) { // CPU ociosa: salta para a próxima chegada
+            tempo_atual = chegada[carga->ordem_chegada[proxima_chegada]];
+            continue;
+        }
+        i = fila_remover(&prontos);
+        res->decisoes++;
+        if (res->inicio[i] == -1) {
+            res->inicio[i] = tempo_atual;
+        }
+        if (i != ultimo) {
+            res->trocas_contexto++;
+            ultimo = i;
+        }
+        fatia = restante[i] <= quantum ? restante[i] : quantum;
+        tempo_atual += fatia;
+        restante[i] -= fatia;
+        if (restante[i] == 0) {
+            res->termino[i] = tempo_atual;
+            finalizados++;
+        } else if (fila_inserir(&prontos, i) != 0) {
+            goto sem_memoria;
+        }
+    }
+    fila_destruir(&prontos);
+    free(restante);
+    return 0;
+
+sem_memoria:
+    fila_destruir(&prontos);
+    free(restante);
+    return -1;
+}
+
+// Prioridade preemptiva orientada a eventos: o processo pronto de maior prioridade
+// executa até terminar ou até a próxima chegada, quando a escolha é refeita.
+static int simular_prioridade(const CargaTrabalho *carga, int parametro, Resultado *res) {
+    const int *chegada = carga->chegada, *duracao = carga->duracao;
+    HeapIndexado prontos;
+    int *restante;
+    int tempo_atual = 0, proxima_chegada = 0, finalizados = 0, ultimo = -1;
+    int i;
+    (void)parametro;
+
+    restante = (int *)malloc(carga->n * sizeof(int));
+    if (restante == NULL || heap_criar(&prontos, carga->n, comparar_prioridade, carga) != 0) {
+        free(restante);
+        return -1;
+    }
+    for (i = 0; i < carga->n; i++) {
+        restante[i] = duracao[i];
+        res->inicio[i] = -1;
+    }
+
+    while (finalizados < carga->n) {
+        int proximo_evento;
+        while (proxima_chegada < carga->n && chegada[carga->ordem_chegada[proxima_chegada]] <= tempo_atual) {
+            heap_inserir_prioridade(&prontos, carga->ordem_chegada[proxima_chegada++]);
+        }
+        i = heap_topo(&prontos);
+        if (i == -1) { // CPU ociosa: salta para a próxima chegada
+            tempo_atual = chegada[carga->ordem_chegada[proxima_chegada]];
+            ultimo = -1;
+            continue;
+        }
+        res->decisoes++;
+        if (res->inicio[i] == -1) {
+            res->inicio[i] = tempo_atual;
+        }
+        if (i != ultimo) {
+            res->trocas_contexto++;
+            ultimo = i;
+        }
+        proximo_evento = tempo_atual + restante[i];
+        if (proxima_chegada < carga->n && chegada[carga->ordem_chegada[proxima_chegada]] < proximo_evento) {
+            proximo_evento = chegada[carga->ordem_chegada[proxima_chegada]];
+        }
+        restante[i] -= proximo_evento - tempo_atual;
+        tempo_atual = proximo_evento;
+        if (restante[i] == 0) {
+            res->termino[i] = tempo_atual;
+            heap_remover_prioridade(&prontos, i);
+            finalizados++;
+            ultimo = -1;
+        }
+    }
+    heap_destruir(&prontos);
+    free(restante);
+    return 0;
+}
+
+const Politica politica_fcfs = {"FCFS", 0, simular_fcfs};
+const Politica politica_sjf = {"SJF", 0, simular_sjf};
+const Politica politica_srtf = {"SRTF", 0, simular_srtf};
+const Politica politica_rr = {"Round Robin", 1, simular_rr};
+const Politica politica_prioridade = {"Prioridade", 0, simular_prioridade};
+
+// --- Execução ---
+
+int motor_preparar_resultado(Resultado *res, const CargaTrabalho *carga, const Politica *politica, int parametro) {
+    res->politica = politica;
+    res->parametro = parametro;
+    res->inicio = (int *)malloc(carga->n * sizeof(int));
+    res->termino = (int *)malloc(carga->n * sizeof(int));
+    res->espera = (int *)malloc(carga->n * sizeof(int));
+    res->retorno = (int *)malloc(carga->n * sizeof(int));
+    res->segundos = 0;
+    if (res->inicio == NULL || res->termino == NULL || res->espera == NULL || res->retorno == NULL) {
+        motor_liberar_resultado(res);
+        return -1;
+    }
+    return 0;
+}
+
+void motor_liberar_resultado(Resultado *res) {
+    free(res->inicio);
+    free(res->termino);
+    free(res->espera);
+    free(res->retorno);
+    res->inicio = res->termino = res->espera = res->retorno = NULL;
+}
+
+int motor_executar(const CargaTrabalho *carga, Resultado *res) {
+    struct timespec t0, t1;
+
+    // Os contadores são zerados aqui para que um Resultado possa ser reaproveitado
+    // em várias execuções (por exemplo, com quanta diferentes)
+    res->trocas_contexto = 0;
+    res->decisoes = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (res->politica->simular(carga, res->parametro, res) != 0) return -1;
+    motor_calcular_metricas(carga, res);
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    res->segundos = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    return 0;
+}
+
+void motor_calcular_metricas(const CargaTrabalho *carga, Resultado *res) {
+    TotaisMetricas totais;
+    int i;
+
+    // Com o escalonamento conhecido, espera e retorno de todos os processos e seus
+    // totais (em 64 bits) saem de uma única passada sobre as colunas
+    totais = metricas_calcular(carga->n, carga->chegada, carga->duracao, res->termino,
+                               res->espera, res->retorno);
+    res->soma_espera = totais.soma_espera;
+    res->soma_retorno = totais.soma_retorno;
+    res->maior_espera = totais.maior_espera;
+    res->tempo_total = totais.maior_termino;
+    hist_iniciar(&res->hist_espera);
+    hist_iniciar(&res->hist_retorno);
+    for (i = 0; i < carga->n; i++) {
+        hist_registrar(&res->hist_espera, res->espera[i]);
+        hist_registrar(&res->hist_retorno, res->retorno[i]);
+    }
+}
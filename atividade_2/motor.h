@@ -0,0 +1,91 @@
+/*
+ * Motor de simulação de escalonamento compartilhado.
+ * Uma carga de trabalho é lida uma única vez e fica imutável (somente leitura); cada
+ * política de escalonamento (FCFS, SJF, SRTF, Round Robin e Prioridade) é um "plug-in" com
+ * a mesma assinatura, que simula a carga inteira e preenche o seu próprio Resultado.
+ * Como a carga nunca é alterada e cada política escreve apenas no seu Resultado,
+ * várias políticas podem ser simuladas ao mesmo tempo em threads diferentes.
+ *
+ * Compilação (junto com o programa que usa o motor):
+ *     gcc -O2 -pthread -o comparador comparador.c motor.c
+ */
+
+#ifndef MOTOR_H
+#define MOTOR_H
+
+#include "histograma.h" // Distribuição das esperas e retornos de cada política
+
+// Carga de trabalho compartilhada entre as políticas, armazenada por colunas
+// (structure of arrays): cada campo fica em um vetor contíguo próprio, de modo que
+// os laços que percorrem um único campo leem apenas a memória desse campo.
+// O processo de índice i tem ID i + 1.
+typedef struct {
+    int n;                // Quantidade de processos
+    int *chegada;         // Tempo de chegada de cada processo
+    int *duracao;         // Duração (tempo de CPU) de cada processo
+    int *prioridade;      // Prioridade (menor valor = maior prioridade)
+    int *ordem_chegada;   // Índices dos processos ordenados por (chegada, ID)
+} CargaTrabalho;
+
+struct Politica;
+
+// Resultado da simulação de uma carga por uma política. As colunas por processo
+// têm n posições, na mesma ordem das colunas de CargaTrabalho.
+typedef struct {
+    const struct Politica *politica;
+    int parametro;                 // Parâmetro usado (quantum no Round Robin)
+    int *inicio;                   // Primeira vez que cada processo ocupou a CPU
+    int *termino;                  // Momento em que cada processo terminou
+    int *espera;                   // Tempo total na fila de prontos
+    int *retorno;                  // Tempo de retorno (turnaround)
+    long long soma_espera;
+    long long soma_retorno;
+    Histograma hist_espera;        // Percentis de espera (memória fixa, sem ordenação)
+    Histograma hist_retorno;       // Percentis de retorno
+    int maior_espera;
+    int tempo_total;               // Término do último processo
+    long trocas_contexto;          // Vezes em que a CPU passou a outro processo
+    long decisoes;                 // Vezes em que o escalonador escolheu um processo para a CPU
+    double segundos;               // Tempo real gasto na simulação
+} Resultado;
+
+// Política de escalonamento: simula `carga` inteira e preenche as colunas `inicio` e
+// `termino` e os contadores `trocas_contexto` e `decisoes` de `res`. Retorna 0 em caso de sucesso e -1 se faltar memória.
+typedef struct Politica {
+    const char *nome;
+    int usa_parametro;  // 1 se a política usa `parametro` (quantum)
+    int (*simular)(const CargaTrabalho *carga, int parametro, Resultado *res);
+} Politica;
+
+extern const Politica politica_fcfs;
+extern const Politica politica_sjf;
+extern const Politica politica_srtf;
+extern const Politica politica_rr;
+extern const Politica politica_prioridade;
+
+// Carrega a carga de um arquivo (CSV ou binário, ver carga.h) ou, se caminho for NULL,
+// pelo terminal. Retorna 0 em caso de sucesso e -1 em caso de erro.
+int motor_carregar(CargaTrabalho *carga, const char *caminho);
+void motor_liberar_carga(CargaTrabalho *carga);
+
+// Aloca as colunas de uma carga com n processos, a serem preenchidas pelo chamador
+// (por exemplo, pelo gerador de cargas sintéticas). Retorna 0 ou -1 se faltar memória.
+int motor_alocar_carga(CargaTrabalho *carga, int n);
+
+// Calcula `ordem_chegada` a partir das colunas já preenchidas (motor_carregar faz isso
+// sozinho), em tempo linear. Retorna 0 ou -1 se faltar memória.
+int motor_indexar_chegadas(CargaTrabalho *carga);
+
+// Prepara `res` para receber a simulação de `carga` pela política indicada.
+int motor_preparar_resultado(Resultado *res, const CargaTrabalho *carga, const Politica *politica, int parametro);
+void motor_liberar_resultado(Resultado *res);
+
+// Executa a política de `res` sobre a carga, medindo o tempo gasto e calculando os totais.
+// Um mesmo Resultado pode ser executado várias vezes (os contadores são zerados a cada vez).
+int motor_executar(const CargaTrabalho *carga, Resultado *res);
+
+// Calcula espera, retorno, totais e histogramas a partir das colunas `termino` já
+// preenchidas (motor_executar faz isso sozinho; útil para simuladores fora do motor).
+void motor_calcular_metricas(const CargaTrabalho *carga, Resultado *res);
+
+#endif // MOTOR_H
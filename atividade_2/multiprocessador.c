@@ -0,0 +1,455 @@
+/*
+ * Simulador de Escalonamento Multiprocessador (SMP)
+ * Este programa simula m CPUs executando a mesma carga com FCFS, Round Robin ou
+ * Prioridade preemptiva. Cada CPU tem a sua própria fila de prontos (fila circular no
+ * FCFS e no Round Robin, heap na Prioridade) e o seu próprio relógio de eventos:
+ * - um processo que chega é colocado na fila de uma CPU, em rodízio (a CPU "que o acordou");
+ * - uma CPU sem nada na própria fila rouba o próximo processo da CPU com a fila mais longa;
+ * - quando um processo entra na fila de uma CPU ocupada e há CPUs ociosas, uma delas o rouba.
+ *
+ * A simulação é orientada a eventos: um heap de CPUs ocupadas, ordenado pelo próximo
+ * evento (fim de fatia ou término), e outro com as CPUs ordenadas pelo tamanho da fila
+ * dão o próximo evento e a vítima de um roubo em O(log m), sem percorrer as m CPUs a
+ * cada unidade de tempo. Eventos simultâneos são tratados em lote: primeiro as CPUs que
+ * terminaram a fatia, depois as chegadas e por fim a escolha das CPUs liberadas ou
+ * acordadas, que já veem todos os processos que chegaram naquele instante.
+ *
+ * Com uma única CPU, FCFS e Prioridade coincidem com os programas de uma CPU. No Round
+ * Robin, um processo que chega durante uma fatia entra na fila antes do processo
+ * preemptado (por ordem de entrada na fila), e não depois dele como em round_robin.c.
+ *
+ * Compilação: gcc -O2 -pthread -o multiprocessador multiprocessador.c motor.c
+ * Uso: ./multiprocessador -c cpus [-p fcfs|rr|prioridade] [-q quantum] [-e arquivo_de_carga] [-r]
+ *   -c: número de CPUs
+ *   -p: política (padrão: fcfs)
+ *   -q: quantum do Round Robin (padrão: 4)
+ *   -e: lê os processos de um arquivo (CSV ou binário, ver carga.h)
+ *   -r: exibe apenas o resumo, sem a tabela por CPU
+ */
+
+#include <stdio.h>
+#include <stdlib.h>        // Para malloc, calloc, free, atoi
+#include <string.h>        // Para strcmp
+#include <limits.h>        // Para INT_MAX
+#include <unistd.h>        // Para getopt
+#include "motor.h"         // Carga de trabalho, Resultado e cálculo das métricas
+#include "heap.h"          // Filas de prontos da Prioridade e heaps de CPUs
+#include "fila_circular.h" // Filas de prontos do FCFS e do Round Robin
+
+typedef enum {
+    SMP_FCFS,
+    SMP_RR,
+    SMP_PRIORIDADE
+} PoliticaSmp;
+
+// Estado de uma CPU simulada
+typedef struct {
+    FilaCircular fila;        // Fila de prontos (FCFS e Round Robin)
+    HeapIndexado heap;        // Fila de prontos (Prioridade), com posições compartilhadas
+    int atual;                // Processo em execução, ou -1 se a CPU está livre
+    int ultimo;               // Último processo executado (para contar trocas de contexto)
+    int inicio_fatia;         // Quando `atual` começou a executar nesta fatia
+    int ociosa;               // Posição na pilha de CPUs ociosas, ou -1
+    long long ocupado;        // Tempo total gasto executando processos
+    long despachos;           // Vezes em que um processo foi escolhido para esta CPU
+    long trocas_contexto;
+    long roubos;              // Processos tirados da fila de outra CPU
+} Cpu;
+
+typedef struct {
+    const CargaTrabalho *carga;
+    Resultado *res;           // Colunas inicio e termino preenchidas pela simulação
+    PoliticaSmp politica;
+    int quantum;
+    int m;
+    Cpu *cpus;
+    int *restante;            // Tempo de CPU que falta a cada processo
+    int *ultima_cpu;          // CPU em que cada processo executou pela última vez (-1 = nunca)
+    int *posicoes;            // Vetor `posicao` compartilhado pelos heaps de prontos
+    int *tempo_evento;        // Próximo evento de cada CPU ocupada
+    HeapIndexado eventos;     // CPUs ocupadas, pelo próximo evento
+    HeapIndexado filas;       // Todas as CPUs, da fila mais longa para a mais curta
+    int *ociosas;             // Pilha de CPUs ociosas
+    int n_ociosas;
+    int *liberadas;           // CPUs que devem escolher um processo no instante atual
+    int n_liberadas;
+    long migracoes;           // Retomadas de processos em CPU diferente da anterior
+} Smp;
+
+// Ordem da Prioridade: menor valor de prioridade, depois menor chegada, depois menor ID
+static int comparar_prioridade(int a, int b, const void *contexto) {
+    const CargaTrabalho *c = (const CargaTrabalho *)contexto;
+    if (c->prioridade[a] != c->prioridade[b]) return c->prioridade[a] < c->prioridade[b] ? -1 : 1;
+    if (c->chegada[a] != c->chegada[b]) return c->chegada[a] < c->chegada[b] ? -1 : 1;
+    return a - b;
+}
+
+// CPUs ocupadas: menor instante do próximo evento, depois menor número de CPU
+static int comparar_evento(int a, int b, const void *contexto) {
+    const Smp *s = (const Smp *)contexto;
+    if (s->tempo_evento[a] != s->tempo_evento[b]) return s->tempo_evento[a] < s->tempo_evento[b] ? -1 : 1;
+    return a - b;
+}
+
+static int tamanho_fila(const Smp *s, int c) {
+    return s->politica == SMP_PRIORIDADE ? s->cpus[c].heap.tamanho : (int)s->cpus[c].fila.tamanho;
+}
+
+// CPUs por fila: a mais longa primeiro (vítima preferida dos roubos), depois menor número
+static int comparar_fila(int a, int b, const void *contexto) {
+    const Smp *s = (const Smp *)contexto;
+    int ta = tamanho_fila(s, a), tb = tamanho_fila(s, b);
+    if (ta != tb) return ta > tb ? -1 : 1;
+    return a - b;
+}
+
+// --- Filas de prontos por CPU ---
+
+static int enfileirar(Smp *s, int c, int i) {
+    if (s->politica == SMP_PRIORIDADE) {
+        if (heap_reservar(&s->cpus[c].heap) != 0) return -1;
+        heap_inserir(&s->cpus[c].heap, i);
+    } else if (fila_inserir(&s->cpus[c].fila, i) != 0) {
+        return -1;
+    }
+    heap_atualizar(&s->filas, c);
+    return 0;
+}
+
+// Retira o próximo processo da fila da CPU c, ou -1 se ela estiver vazia
+static int desenfileirar(Smp *s, int c) {
+    int i = s->politica == SMP_PRIORIDADE ? heap_remover_topo(&s->cpus[c].heap) : fila_remover(&s->cpus[c].fila);
+    if (i != -1) {
+        heap_atualizar(&s->filas, c);
+    }
+    return i;
+}
+
+// --- CPUs ociosas ---
+
+static void marcar_ociosa(Smp *s, int c) {
+    s->cpus[c].ociosa = s->n_ociosas;
+    s->ociosas[s->n_ociosas++] = c;
+    s->cpus[c].ultimo = -1;
+}
+
+static void desmarcar_ociosa(Smp *s, int c) {
+    int pos = s->cpus[c].ociosa, ultima = s->ociosas[--s->n_ociosas];
+    s->ociosas[pos] = ultima;
+    s->cpus[ultima].ociosa = pos;
+    s->cpus[c].ociosa = -1;
+}
+
+// --- Execução ---
+
+// Coloca o processo i para executar na CPU c no instante t
+static void despachar(Smp *s, int c, int i, int t) {
+    Cpu *cpu = &s->cpus[c];
+    int fatia = s->politica == SMP_RR && s->restante[i] > s->quantum ? s->quantum : s->restante[i];
+
+    cpu->atual = i;
+    cpu->inicio_fatia = t;
+    cpu->despachos++;
+    s->res->decisoes++;
+    if (s->res->inicio[i] == -1) {
+        s->res->inicio[i] = t;
+    }
+    if (s->ultima_cpu[i] != -1 && s->ultima_cpu[i] != c) {
+        s->migracoes++;
+    }
+    s->ultima_cpu[i] = c;
+    if (i != cpu->ultimo) {
+        cpu->trocas_contexto++;
+        s->res->trocas_contexto++;
+        cpu->ultimo = i;
+    }
+    s->tempo_evento[c] = t + fatia;
+    if (heap_contem(&s->eventos, c)) heap_atualizar(&s->eventos, c);
+    else heap_inserir(&s->eventos, c);
+}
+
+// Interrompe a CPU c no instante t e retorna o processo que executava nela
+static int parar(Smp *s, int c, int t) {
+    Cpu *cpu = &s->cpus[c];
+    int i = cpu->atual;
+    s->restante[i] -= t - cpu->inicio_fatia;
+    cpu->ocupado += t - cpu->inicio_fatia;
+    cpu->atual = -1;
+    heap_remover(&s->eventos, c);
+    return i;
+}
+
+// A CPU livre c escolhe o próximo processo: da própria fila ou, se ela estiver vazia,
+// da CPU com a fila mais longa. Sem nada para executar, a CPU fica ociosa.
+static void escolher(Smp *s, int c, int t) {
+    int i = desenfileirar(s, c);
+    if (i == -1) {
+        int vitima = heap_topo(&s->filas);
+        if (tamanho_fila(s, vitima) > 0) {
+            i = desenfileirar(s, vitima);
+            s->cpus[c].roubos++;
+        }
+    }
+    if (i != -1) despachar(s, c, i, t);
+    else marcar_ociosa(s, c);
+}
+
+// Tira a CPU ociosa c da pilha; ela escolhe um processo ao fim do instante atual
+static void acordar(Smp *s, int c) {
+    desmarcar_ociosa(s, c);
+    s->liberadas[s->n_liberadas++] = c;
+}
+
+// Chegada do processo i no instante t à CPU c
+static int chegar(Smp *s, int c, int i, int t) {
+    Cpu *cpu = &s->cpus[c];
+    if (cpu->ociosa != -1) {
+        acordar(s, c);
+    } else if (cpu->atual != -1 && s->politica == SMP_PRIORIDADE &&
+               comparar_prioridade(i, cpu->atual, s->carga) < 0) {
+        // Preempção: o processo em execução volta para a fila e a CPU escolhe de novo
+        // ao fim do instante, já considerando as demais chegadas simultâneas
+        if (enfileirar(s, c, parar(s, c, t)) != 0) return -1;
+        s->liberadas[s->n_liberadas++] = c;
+    }
+    if (enfileirar(s, c, i) != 0) return -1;
+    // Processo que vai ficar esperando na fila enquanto há CPUs ociosas: uma delas o rouba
+    if (s->n_ociosas > 0 && (cpu->atual != -1 || tamanho_fila(s, c) > 1)) {
+        acordar(s, s->ociosas[s->n_ociosas - 1]);
+    }
+    return 0;
+}
+
+// Simula a carga inteira. Retorna 0 ou -1 se faltar memória.
+static int simular(Smp *s) {
+    const CargaTrabalho *carga = s->carga;
+    int n = carga->n, proxima_chegada = 0, finalizados = 0, proxima_cpu = 0;
+    int k;
+
+    while (finalizados < n) {
+        int c = heap_topo(&s->eventos);
+        int t_cpu = c != -1 ? s->tempo_evento[c] : INT_MAX;
+        int t_chegada = proxima_chegada < n ? carga->chegada[carga->ordem_chegada[proxima_chegada]] : INT_MAX;
+        int t = t_cpu < t_chegada ? t_cpu : t_chegada;
+
+        // 1) CPUs cuja fatia termina agora: o processo termina ou volta para a fila
+        s->n_liberadas = 0;
+        while ((c = heap_topo(&s->eventos)) != -1 && s->tempo_evento[c] == t) {
+            int i = parar(s, c, t);
+            if (s->restante[i] == 0) {
+                s->res->termino[i] = t;
+                finalizados++;
+            } else if (enfileirar(s, c, i) != 0) {
+                return -1;
+            }
+            s->liberadas[s->n_liberadas++] = c;
+        }
+        // 2) Chegadas deste instante, distribuídas em rodízio entre as CPUs
+        while (proxima_chegada < n && carga->chegada[carga->ordem_chegada[proxima_chegada]] == t) {
+            if (chegar(s, proxima_cpu, carga->ordem_chegada[proxima_chegada++], t) != 0) return -1;
+            proxima_cpu = proxima_cpu + 1 < s->m ? proxima_cpu + 1 : 0;
+        }
+        // 3) As CPUs liberadas ou acordadas escolhem o próximo processo: primeiro as que
+        //    têm processos na própria fila, para que as demais não os roubem à toa
+        for (k = 0; k < s->n_liberadas; k++) {
+            c = s->liberadas[k];
+            if (s->cpus[c].atual == -1 && tamanho_fila(s, c) > 0) escolher(s, c, t);
+        }
+        for (k = 0; k < s->n_liberadas; k++) {
+            c = s->liberadas[k];
+            if (s->cpus[c].atual == -1) escolher(s, c, t);
+        }
+    }
+    return 0;
+}
+
+static void liberar_smp(Smp *s) {
+    int c;
+    if (s->cpus != NULL) {
+        for (c = 0; c < s->m; c++) {
+            fila_destruir(&s->cpus[c].fila);
+            if (s->cpus[c].heap.itens != NULL) heap_destruir(&s->cpus[c].heap);
+        }
+    }
+    if (s->eventos.itens != NULL) heap_destruir(&s->eventos);
+    if (s->filas.itens != NULL) heap_destruir(&s->filas);
+    free(s->cpus);
+    free(s->restante);
+    free(s->ultima_cpu);
+    free(s->posicoes);
+    free(s->tempo_evento);
+    free(s->ociosas);
+    free(s->liberadas);
+}
+
+// Prepara o estado da simulação. Retorna 0 ou -1 se faltar memória.
+static int preparar_smp(Smp *s, const CargaTrabalho *carga, Resultado *res, PoliticaSmp politica, int quantum, int m) {
+    int c, i, n = carga->n;
+
+    s->carga = carga;
+    s->res = res;
+    s->politica = politica;
+    s->quantum = quantum;
+    s->m = m;
+    s->n_ociosas = s->n_liberadas = 0;
+    s->migracoes = 0;
+    s->eventos.itens = s->filas.itens = NULL;
+    s->cpus = (Cpu *)calloc(m, sizeof(Cpu));
+    s->restante = (int *)malloc(n * sizeof(int));
+    s->ultima_cpu = (int *)malloc(n * sizeof(int));
+    s->posicoes = (int *)malloc(n * sizeof(int));
+    s->tempo_evento = (int *)malloc(m * sizeof(int));
+    s->ociosas = (int *)malloc(m * sizeof(int));
+    s->liberadas = (int *)malloc(m * sizeof(int));
+    if (s->cpus == NULL || s->restante == NULL || s->ultima_cpu == NULL || s->posicoes == NULL ||
+        s->tempo_evento == NULL || s->ociosas == NULL || s->liberadas == NULL ||
+        heap_criar(&s->eventos, m, comparar_evento, s) != 0 ||
+        heap_criar(&s->filas, m, comparar_fila, s) != 0) {
+        liberar_smp(s);
+        return -1;
+    }
+    for (i = 0; i < n; i++) {
+        s->restante[i] = carga->duracao[i];
+        s->ultima_cpu[i] = -1;
+        s->posicoes[i] = -1;
+        res->inicio[i] = -1;
+    }
+    for (c = 0; c < m; c++) {
+        Cpu *cpu = &s->cpus[c];
+        cpu->atual = cpu->ultimo = -1;
+        if (politica == SMP_PRIORIDADE) {
+            if (heap_criar_compartilhado(&cpu->heap, s->posicoes, n, comparar_prioridade, carga) != 0) {
+                liberar_smp(s);
+                return -1;
+            }
+        } else if (fila_criar(&cpu->fila) != 0) {
+            liberar_smp(s);
+            return -1;
+        }
+        heap_inserir(&s->filas, c);
+    }
+    // Todas as CPUs começam ociosas, com a CPU 0 no topo da pilha
+    for (c = m - 1; c >= 0; c--) {
+        marcar_ociosa(s, c);
+    }
+    res->trocas_contexto = 0;
+    res->decisoes = 0;
+    return 0;
+}
+
+static void exibir_resultados(const Smp *s, const Resultado *res, int resumido) {
+    const char *nomes[] = {"FCFS", "Round Robin", "Prioridade"};
+    int n = s->carga->n, m = s->m, c;
+    long long soma_ocupado = 0, maior_ocupado = 0, menor_ocupado = -1;
+    long roubos = 0;
+    double media_ocupado;
+
+    for (c = 0; c < m; c++) {
+        long long o = s->cpus[c].ocupado;
+        soma_ocupado += o;
+        if (o > maior_ocupado) maior_ocupado = o;
+        if (menor_ocupado == -1 || o < menor_ocupado) menor_ocupado = o;
+        roubos += s->cpus[c].roubos;
+    }
+    media_ocupado = (double)soma_ocupado / m;
+
+    if (!resumido) {
+        printf("\n--- Uso das CPUs ---\n");
+        printf("+-------+-------------+--------------+--------------+--------------+\n");
+        printf("| %-5s | %-11s | %-12s | %-12s | %-12s |\n", "CPU", "Utilização", "Despachos", "Trocas", "Roubos");
+        printf("+-------+-------------+--------------+--------------+--------------+\n");
+        for (c = 0; c < m; c++) {
+            printf("| %-5d | %10.2f%% | %12ld | %12ld | %12ld |\n", c,
+                   res->tempo_total > 0 ? 100.0 * s->cpus[c].ocupado / res->tempo_total : 0.0,
+                   s->cpus[c].despachos, s->cpus[c].trocas_contexto, s->cpus[c].roubos);
+        }
+        printf("+-------+-------------+--------------+--------------+--------------+\n");
+    }
+
+    printf("\n--- Resumo (%s, %d CPUs, %d processos) ---\n", nomes[s->politica], m, n);
+    printf("Tempo médio de espera: %.2f unidades de tempo\n", (double)res->soma_espera / n);
+    printf("Tempo médio de retorno: %.2f unidades de tempo\n", (double)res->soma_retorno / n);
+    hist_exibir_percentis("espera", &res->hist_espera);
+    hist_exibir_percentis("retorno", &res->hist_retorno);
+    printf("Tempo total: %d\n", res->tempo_total);
+    printf("Utilização média das CPUs: %.2f%% (mínima %.2f%%, máxima %.2f%%)\n",
+           res->tempo_total > 0 ? 100.0 * media_ocupado / res->tempo_total : 0.0,
+           res->tempo_total > 0 ? 100.0 * menor_ocupado / res->tempo_total : 0.0,
+           res->tempo_total > 0 ? 100.0 * maior_ocupado / res->tempo_total : 0.0);
+    // Desequilíbrio: quanto a CPU mais ocupada trabalhou além da média
+    printf("Desequilíbrio de carga: %.2f%%\n", media_ocupado > 0 ? 100.0 * (maior_ocupado / media_ocupado - 1) : 0.0);
+    printf("Trocas de contexto: %ld\n", res->trocas_contexto);
+    printf("Roubos de trabalho: %ld\n", roubos);
+    printf("Migrações: %ld\n", s->migracoes);
+}
+
+int main(int argc, char *argv[]) {
+    CargaTrabalho carga;
+    Resultado res;
+    Smp smp;
+    PoliticaSmp politica = SMP_FCFS;
+    const char *arquivo_entrada = NULL;
+    int m = 0, quantum = 4, resumido = 0, opcao, status = 0;
+
+    while ((opcao = getopt(argc, argv, "c:p:q:e:r")) != -1) {
+        switch (opcao) {
+        case 'c':
+            m = atoi(optarg);
+            break;
+        case 'p':
+            if (strcmp(optarg, "fcfs") == 0) politica = SMP_FCFS;
+            else if (strcmp(optarg, "rr") == 0) politica = SMP_RR;
+            else if (strcmp(optarg, "prioridade") == 0) politica = SMP_PRIORIDADE;
+            else {
+                fprintf(stderr, "Erro: Política '%s' desconhecida (use fcfs, rr ou prioridade).\n", optarg);
+                return 1;
+            }
+            break;
+        case 'q':
+            quantum = atoi(optarg);
+            break;
+        case 'e':
+            arquivo_entrada = optarg;
+            break;
+        case 'r':
+            resumido = 1;
+            break;
+        default:
+            fprintf(stderr, "Uso: %s -c cpus [-p fcfs|rr|prioridade] [-q quantum] [-e arquivo_de_carga] [-r]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (m <= 0 || quantum <= 0) {
+        fprintf(stderr, "Erro: Informe o número de CPUs com -c e um quantum positivo.\n");
+        return 1;
+    }
+
+    printf("Simulador de Escalonamento Multiprocessador\n");
+    printf("-------------------------------------------\n");
+
+    if (motor_carregar(&carga, arquivo_entrada) != 0) {
+        return 1;
+    }
+    if (motor_preparar_resultado(&res, &carga, NULL, quantum) != 0 ||
+        preparar_smp(&smp, &carga, &res, politica, quantum, m) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a simulação!\n");
+        motor_liberar_resultado(&res);
+        motor_liberar_carga(&carga);
+        return 1;
+    }
+
+    printf("\n--- Executando em %d CPUs ---\n", m);
+    if (simular(&smp) != 0) {
+        fprintf(stderr, "Erro: Falha de memória durante a simulação.\n");
+        status = 1;
+    } else {
+        motor_calcular_metricas(&carga, &res);
+        exibir_resultados(&smp, &res, resumido);
+        printf("\nSimulação multiprocessador concluída.\n");
+    }
+
+    liberar_smp(&smp);
+    motor_liberar_resultado(&res);
+    motor_liberar_carga(&carga);
+    return status;
+}
@@ -0,0 +1,116 @@
+/*
+ * Ordenações especializadas em tempo de compilação.
+ * Em vez de uma função de comparação chamada por ponteiro (qsort), a ordem é dada por
+ * macros expandidas dentro do próprio código que ordena, o que permite ao compilador
+ * gerar uma versão dedicada a cada chave, sem chamadas indiretas.
+ *
+ * - ORDENACAO_RADIX(nome, Tipo, Contexto, CHAVE) gera
+ *   `static int nome(Tipo *v, int n, Contexto contexto)`, que ordena v de forma estável
+ *   pela chave inteira CHAVE(elemento, contexto) com radix sort LSD (4 passadas de
+ *   8 bits), em tempo linear. Por ser estável, elementos de mesma chave mantêm a ordem
+ *   em que estavam: ordenar índices 0..n-1 por chegada dá o desempate pelo ID. Passadas
+ *   em que todos os elementos têm o mesmo dígito são puladas (chegadas pequenas usam
+ *   menos passadas) e uma carga já ordenada é detectada e não é copiada. Usa um vetor
+ *   auxiliar de n elementos; retorna 0 ou -1 se a alocação falhar.
+ *
+ * - COMPARADOR_PROCESSOS(nome, Tipo, campo) gera o comparador
+ *   `int nome(int a, int b, const void *contexto)` de índices em um vetor de Tipo
+ *   (o contexto) com a ordem usada pelas filas de prontos: menor `campo`, depois menor
+ *   chegada, depois menor ID. Junto com HEAP_ESPECIALIZAR (heap.h), o comparador é
+ *   expandido dentro das operações do heap.
+ *
+ * Exemplo:
+ *     #define CHAVE_CHEGADA(idx, p) ((p)[idx].chegada)
+ *     ORDENACAO_RADIX(ordenar_por_chegada, int, const Processo *, CHAVE_CHEGADA)
+ *     COMPARADOR_PROCESSOS(comparar_duracao, Processo, duracao)
+ *
+ * Uso: basta incluir este arquivo; as funções geradas são `static`.
+ */
+
+#ifndef ORDENACAO_H
+#define ORDENACAO_H
+
+#include <stdint.h> // Para uint32_t
+#include <stdlib.h> // Para malloc, free
+#include <string.h> // Para memset, memcpy
+
+#define ORDENACAO_LIMIAR_INSERCAO 64 // Abaixo disso, ordenação por inserção
+
+// Chave inteira com sinal levada para sem sinal preservando a ordem (negativos primeiro)
+static inline uint32_t ordenacao_chave(int chave) {
+    return (uint32_t)chave ^ 0x80000000u;
+}
+
+#define ORDENACAO_RADIX(nome, Tipo, Contexto, CHAVE)                                       \
+static int nome(Tipo *v, int n, Contexto contexto) {                                       \
+    size_t contagem[4][256];                                                               \
+    Tipo *origem = v, *destino, *aux;                                                      \
+    int i, passada, ordenado = 1;                                                          \
+    (void)contexto;                                                                        \
+                                                                                           \
+    /* Poucos elementos: inserção (estável), sem vetor auxiliar */                         \
+    if (n < ORDENACAO_LIMIAR_INSERCAO) {                                                   \
+        for (i = 1; i < n; i++) {                                                          \
+            Tipo x = v[i];                                                                 \
+            int j = i - 1;                                                                 \
+            while (j >= 0 && CHAVE(v[j], contexto) > CHAVE(x, contexto)) {                 \
+                v[j + 1] = v[j];                                                           \
+                j--;                                                                       \
+            }                                                                              \
+            v[j + 1] = x;                                                                  \
+        }                                                                                  \
+        return 0;                                                                          \
+    }                                                                                      \
+                                                                                           \
+    /* Uma leitura conta os dígitos das 4 passadas e verifica se já está ordenado */       \
+    memset(contagem, 0, sizeof(contagem));                                                 \
+    for (i = 0; i < n; i++) {                                                              \
+        uint32_t k = ordenacao_chave(CHAVE(v[i], contexto));                               \
+        contagem[0][k & 255]++;                                                            \
+        contagem[1][(k >> 8) & 255]++;                                                     \
+        contagem[2][(k >> 16) & 255]++;                                                    \
+        contagem[3][k >> 24]++;                                                            \
+        if (i > 0 && CHAVE(v[i - 1], contexto) > CHAVE(v[i], contexto)) ordenado = 0;      \
+    }                                                                                      \
+    if (ordenado) return 0;                                                                \
+                                                                                           \
+    aux = (Tipo *)malloc((size_t)n * sizeof(Tipo));                                        \
+    if (aux == NULL) return -1;                                                            \
+    destino = aux;                                                                         \
+    for (passada = 0; passada < 4; passada++) {                                            \
+        size_t *c = contagem[passada], soma = 0;                                           \
+        int deslocamento = 8 * passada, d;                                                 \
+        /* Todos com o mesmo dígito: a passada não mudaria nada */                         \
+        if (c[(ordenacao_chave(CHAVE(origem[0], contexto)) >> deslocamento) & 255] ==      \
+            (size_t)n) {                                                                   \
+            continue;                                                                      \
+        }                                                                                  \
+        for (d = 0; d < 256; d++) { /* Contagens viram posições iniciais */                \
+            size_t t = c[d];                                                               \
+            c[d] = soma;                                                                   \
+            soma += t;                                                                     \
+        }                                                                                  \
+        for (i = 0; i < n; i++) {                                                          \
+            uint32_t k = ordenacao_chave(CHAVE(origem[i], contexto));                      \
+            destino[c[(k >> deslocamento) & 255]++] = origem[i];                           \
+        }                                                                                  \
+        destino = origem; /* Troca os papéis: a próxima passada lê o que esta escreveu */  \
+        origem = destino == v ? aux : v;                                                   \
+    }                                                                                      \
+    if (origem != v) {                                                                     \
+        memcpy(v, origem, (size_t)n * sizeof(Tipo));                                       \
+    }                                                                                      \
+    free(aux);                                                                             \
+    return 0;                                                                              \
+}
+
+#define COMPARADOR_PROCESSOS(nome, Tipo, campo)                                            \
+static inline int nome(int a, int b, const void *contexto) {                               \
+    const Tipo *p1 = &((const Tipo *)contexto)[a];                                         \
+    const Tipo *p2 = &((const Tipo *)contexto)[b];                                         \
+    if (p1->campo != p2->campo) return p1->campo < p2->campo ? -1 : 1;                     \
+    if (p1->chegada != p2->chegada) return p1->chegada < p2->chegada ? -1 : 1;             \
+    return p1->id - p2->id;                                                                \
+}
+
+#endif // ORDENACAO_H
@@ -7,6 +7,32 @@
  * O critério de prioridade adotado é: menor valor numérico indica maior prioridade.
  * Em caso de empate na prioridade, o desempate é feito pelo tempo de chegada (FCFS) e,
  * persistindo o empate, pelo menor ID do processo.
+ * A simulação é orientada a eventos: o relógio salta diretamente para o próximo término
+ * ou chegada, de modo que o custo depende do número de eventos e não do tempo simulado.
+ *
+ * Envelhecimento (opção -a periodo): para evitar que processos de baixa prioridade
+ * esperem indefinidamente, a prioridade efetiva de um processo melhora um nível a cada
+ * `periodo` unidades de tempo que ele passou esperando na fila de prontos:
+ *     efetiva(t) = prioridade - espera_acumulada(t) / periodo
+ * Em vez de atualizar todos os processos a cada instante, cada um carrega a chave
+ *     chave = prioridade * periodo + chegada + tempo_executado
+ * que só muda enquanto o processo executa, pois efetiva(t) = (chave - t) / periodo.
+ * Como o relógio t é o mesmo para todos, comparar as chaves equivale a comparar as
+ * prioridades efetivas em qualquer instante, e a escolha continua custando O(log n).
+ * O processo em execução fica fora do heap; o topo o preempta quando estiver pelo
+ * menos um nível inteiro à frente dele, e esse instante é calculado diretamente e
+ * tratado como mais um evento (o que também garante fatias de pelo menos `periodo`
+ * entre processos de mesma prioridade).
+ *
+ * Com -t arquivo, cada chegada, entrada na CPU, preempção e término é gravado em um
+ * rastro binário (rastro.h); o decodificar_rastro reconstrói a partir dele o log
+ * "Tempo t: Processo x está executando." ou um diagrama de Gantt.
+ *
+ * Execuções longas podem ser pausadas e retomadas: com -c arquivo, o estado completo da
+ * simulação (struct Simulacao) é gravado a cada -k unidades de tempo simulado e ao
+ * receber SIGINT/SIGTERM; -r arquivo continua dali, com resultados idênticos aos de uma
+ * execução sem interrupção (ver checkpoint.h).
+ *
  * O programa calcula e exibe os tempos de início, término, espera e retorno para cada processo,
  * além dos tempos médios de espera e retorno do conjunto de processos.
  * Autor: Antonio André Barcelos Chagas
@@ -15,7 +41,17 @@
 
 #include <stdio.h>
 #include <stdlib.h> // Para malloc, free
-#include <limits.h> // Para INT_MAX
+#include <string.h> // Para memset
+#include <stdint.h> // Para int32_t, int64_t (escalares do checkpoint)
+#include <signal.h> // Para signal (checkpoint ao receber SIGINT/SIGTERM)
+#include <unistd.h> // Para getopt
+#include "heap.h"   // Heap indexado usado como fila de prontos
+#include "ordenacao.h" // Radix sort das chegadas e comparador especializado
+#include "carga.h"  // Leitura da carga de trabalho a partir de arquivo (CSV ou binário)
+#include "saida.h"  // Escrita dos resultados (tabela, CSV, binário ou resumo)
+#include "histograma.h" // Percentis de espera e retorno em memória fixa
+#include "rastro.h"     // Rastro binário da execução (opção -t)
+#include "checkpoint.h" // Checkpoints do estado da simulação (opções -c e -r)
 
 // Estrutura que representa um processo
 typedef struct {
@@ -29,170 +65,602 @@ typedef struct {
     int espera;             // Tempo total de espera do processo
     int retorno;            // Tempo total de retorno (turnaround)
     int finalizado;         // Flag: 1 se o processo terminou, 0 caso contrário
+    int enfileirado;        // Instante em que o processo entrou na fila de prontos pela última vez
+    int maior_espera;       // Maior intervalo contínuo que o processo passou na fila de prontos
+    long long chave;        // Chave no heap: prioridade ou, com envelhecimento, prioridade * periodo + chegada + executado
 } Processo;
 
-int main() {
-    Processo *p = NULL; // Ponteiro para o array de processos
-    int n, i;
-    int tempo_atual = 0;
-    int processos_finalizados = 0;
-    float soma_espera = 0, soma_retorno = 0;
-    int ultimo_processo_executado = -1; // Para rastrear mudanças e registrar início
+// Período de envelhecimento (-a): unidades de espera por nível de prioridade; 0 desliga
+static int periodo_envelhecimento = 0;
 
-    printf("## Escalonamento por Prioridade Preemptivo ##\n");
-    printf("-------------------------------------------\n");
-    printf("(Menor valor numérico indica maior prioridade)\n\n");
+// Ordena índices de processos pela chegada; o radix sort é estável, então o empate
+// fica com a ordem inicial dos índices, que é a dos IDs
+#define CHAVE_CHEGADA(idx, p) ((p)[idx].chegada)
+ORDENACAO_RADIX(ordenar_por_chegada, int, const Processo *, CHAVE_CHEGADA)
+
+// Chave do processo na sua chegada (ver comentário do topo)
+long long chave_inicial(const Processo *p) {
+    if (periodo_envelhecimento == 0) return p->prioridade;
+    return (long long)p->prioridade * periodo_envelhecimento + p->chegada;
+}
+
+// Ordem do heap de prontos: menor chave (prioridade, efetiva se houver envelhecimento),
+// depois menor chegada, depois menor ID
+COMPARADOR_PROCESSOS(comparar_prioridade, Processo, chave)
+
+// Operações do heap com o comparador expandido em tempo de compilação (heap.h)
+HEAP_ESPECIALIZAR(prioridade, comparar_prioridade)
+
+// Lê os processos interativamente pelo terminal.
+// Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+Processo *ler_processos_terminal(int *n) {
+    Processo *p;
+    int i;
 
     // Entrada do número de processos
     printf("Informe o número de processos: ");
-    if (scanf("%d", &n) != 1 || n <= 0) {
+    if (scanf("%d", n) != 1 || *n <= 0) {
         fprintf(stderr, "Erro: Número de processos deve ser um inteiro positivo.\n");
-        return 1;
+        return NULL;
     }
 
     // Alocação dinâmica de memória para os processos
-    p = (Processo *)malloc(n * sizeof(Processo));
+    p = (Processo *)malloc(*n * sizeof(Processo));
     if (p == NULL) {
         fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
-        return 1;
+        return NULL;
     }
 
     // Entrada dos dados dos processos
     printf("\n--- Entrada dos Dados dos Processos ---\n");
-    for (i = 0; i < n; i++) {
+    for (i = 0; i < *n; i++) {
         p[i].id = i + 1;
         printf("Processo %d:\n", p[i].id);
         printf("  Tempo de chegada: ");
         if (scanf("%d", &p[i].chegada) != 1 || p[i].chegada < 0) {
             fprintf(stderr, "Erro: Tempo de chegada inválido para o processo %d (deve ser >= 0).\n", p[i].id);
             free(p);
-            return 1;
+            return NULL;
         }
         printf("  Duração (burst): ");
         if (scanf("%d", &p[i].duracao_original) != 1 || p[i].duracao_original <= 0) {
             fprintf(stderr, "Erro: Duração inválida para o processo %d (deve ser > 0).\n", p[i].id);
             free(p);
-            return 1;
+            return NULL;
         }
         printf("  Prioridade: ");
         if (scanf("%d", &p[i].prioridade) != 1 || p[i].prioridade < 0) { // Prioridade pode ser 0
             fprintf(stderr, "Erro: Prioridade inválida para o processo %d (deve ser >= 0).\n", p[i].id);
             free(p);
-            return 1;
+            return NULL;
         }
-        p[i].restante = p[i].duracao_original;
-        p[i].finalizado = 0;
-        p[i].inicio = -1; // Indica que ainda não começou
-        p[i].termino = 0;
-        p[i].espera = 0;
-        p[i].retorno = 0;
     }
+    return p;
+}
 
-    printf("\n--- Executando Escalonamento por Prioridade Preemptivo ---\n");
+// Lê todos os processos de um arquivo de carga (CSV ou binário) em uma única passada.
+// Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+Processo *carregar_arquivo(const char *caminho, int *n) {
+    LeitorCarga carga;
+    Processo *p;
+    int i;
+
+    if (carga_abrir(&carga, caminho) != 0) return NULL;
+    *n = (int)carga_quantidade(&carga);
+    if (*n <= 0) {
+        fprintf(stderr, "Erro: O arquivo '%s' não contém processos.\n", caminho);
+        carga_fechar(&carga);
+        return NULL;
+    }
+    p = (Processo *)malloc(*n * sizeof(Processo));
+    if (p == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
+        carga_fechar(&carga);
+        return NULL;
+    }
+    for (i = 0; i < *n; i++) {
+        p[i].id = i + 1;
+        if (carga_proximo(&carga, &p[i].chegada, &p[i].duracao_original, &p[i].prioridade) != 1) {
+            free(p);
+            carga_fechar(&carga);
+            return NULL;
+        }
+    }
+    carga_fechar(&carga);
+    printf("%d processos carregados de '%s'.\n", *n, caminho);
+    return p;
+}
 
-    // Loop principal: executa enquanto houver processos não finalizados
-    while (processos_finalizados < n) {
-        int idx_candidato = -1;
-        int maior_prioridade_encontrada = INT_MAX; // Maior valor numérico (menor prioridade)
+// Escreve o resultado de cada processo no formato escolhido (ver saida.h).
+// Retorna 0 em caso de sucesso e -1 em caso de erro.
+int exibir_resultados(const Processo *p, int n, FormatoSaida formato, const char *arquivo_saida) {
+    EscritorResultados saida;
+    LinhaResultado linha = {0}; // Colunas opcionais não usadas ficam zeradas
+    int i;
 
-        // Seleciona o processo pronto com a maior prioridade (menor valor numérico)
+    if (saida_abrir(&saida, formato, arquivo_saida, 1) != 0) return -1;
+    saida.com_maior_espera = 1;
+    saida_cabecalho(&saida, n);
+    if (formato != SAIDA_RESUMO) {
         for (i = 0; i < n; i++) {
-            if (!p[i].finalizado && p[i].chegada <= tempo_atual) {
-                if (p[i].prioridade < maior_prioridade_encontrada) {
-                    maior_prioridade_encontrada = p[i].prioridade;
-                    idx_candidato = i;
-                } else if (p[i].prioridade == maior_prioridade_encontrada) {
-                    // Critério de desempate: menor tempo de chegada
-                    if (p[i].chegada < p[idx_candidato].chegada) {
-                        idx_candidato = i;
-                    }
-                    // Critério de desempate secundário: menor ID (se chegadas iguais)
-                    else if (p[i].chegada == p[idx_candidato].chegada && p[i].id < p[idx_candidato].id) {
-                        idx_candidato = i;
-                    }
-                }
+            linha.id = p[i].id;
+            linha.chegada = p[i].chegada;
+            linha.duracao = p[i].duracao_original;
+            linha.prioridade = p[i].prioridade;
+            linha.inicio = p[i].inicio;
+            linha.termino = p[i].termino;
+            linha.espera = p[i].espera;
+            linha.retorno = p[i].retorno;
+            linha.maior_espera = p[i].maior_espera;
+            saida_linha(&saida, &linha);
+        }
+    }
+    saida_rodape(&saida);
+    return saida_fechar(&saida);
+}
+
+// Estado completo da simulação: tudo o que o laço principal lê e altera entre dois
+// eventos. É o que um checkpoint (-c) grava e o que a retomada (-r) restaura.
+typedef struct {
+    int n;                              // Quantidade de processos
+    Processo *p;                        // Vetor de processos
+    int *ordem_chegada;                 // Índices dos processos ordenados por chegada
+    int proxima_chegada;                // Cursor em ordem_chegada: próximo processo a chegar
+    HeapIndexado prontos;               // Processos prontos (chegaram e não terminaram)
+    int tempo_atual;
+    int processos_finalizados;
+    int atual;                          // Processo em execução (fora do heap), ou -1 se a CPU está ociosa
+    int ultimo_processo_executado;      // Para rastrear mudanças e registrar início
+    int maior_espera;                   // Índice do processo com a maior espera contínua
+    long preempcoes_envelhecimento;     // Preempções causadas pelo envelhecimento
+    Histograma hist_espera, hist_retorno; // Distribuição das esperas e dos retornos (média e percentis)
+} Simulacao;
+
+// Campos escalares de Simulacao, com largura fixa, como gravados no checkpoint
+typedef struct {
+    int32_t n, proxima_chegada, tamanho_heap, tempo_atual, processos_finalizados;
+    int32_t atual, ultimo_processo_executado, maior_espera, periodo_envelhecimento;
+    int64_t preempcoes_envelhecimento;
+} EscalaresCheckpoint;
+
+// Pedido de interrupção (SIGINT/SIGTERM com -c): grava um checkpoint e encerra
+static volatile sig_atomic_t interromper = 0;
+
+void pedir_interrupcao(int sinal) {
+    (void)sinal;
+    interromper = 1;
+}
+
+// Aloca o vetor de ordem de chegada e o heap de prontos para os processos de s->p.
+// Retorna 0 ou -1 se faltar memória.
+int alocar_estruturas(Simulacao *s) {
+    s->ordem_chegada = (int *)malloc(s->n * sizeof(int));
+    if (s->ordem_chegada == NULL || heap_criar(&s->prontos, s->n, comparar_prioridade, s->p) != 0) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+        free(s->ordem_chegada);
+        s->ordem_chegada = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void liberar_simulacao(Simulacao *s) {
+    if (s->ordem_chegada != NULL) {
+        heap_destruir(&s->prontos);
+    }
+    free(s->ordem_chegada);
+    free(s->p);
+    s->ordem_chegada = NULL;
+    s->p = NULL;
+}
+
+// Grava o estado da simulação em `caminho` (ver checkpoint.h).
+// Retorna 0 em caso de sucesso e -1 em caso de erro.
+int gravar_checkpoint(const Simulacao *s, EscritorCheckpoint *e, const char *caminho) {
+    EscalaresCheckpoint esc;
+    memset(&esc, 0, sizeof(esc));
+    esc.n = s->n;
+    esc.proxima_chegada = s->proxima_chegada;
+    esc.tamanho_heap = s->prontos.tamanho;
+    esc.tempo_atual = s->tempo_atual;
+    esc.processos_finalizados = s->processos_finalizados;
+    esc.atual = s->atual;
+    esc.ultimo_processo_executado = s->ultimo_processo_executado;
+    esc.maior_espera = s->maior_espera;
+    esc.periodo_envelhecimento = periodo_envelhecimento;
+    esc.preempcoes_envelhecimento = s->preempcoes_envelhecimento;
+
+    checkpoint_iniciar(e);
+    checkpoint_secao(e, &esc, sizeof(esc));
+    checkpoint_secao(e, s->p, s->n * sizeof(Processo));
+    checkpoint_secao(e, s->ordem_chegada, s->n * sizeof(int));
+    checkpoint_secao(e, s->prontos.itens, s->prontos.tamanho * sizeof(int));
+    checkpoint_secao(e, &s->hist_espera, sizeof(Histograma));
+    checkpoint_secao(e, &s->hist_retorno, sizeof(Histograma));
+    return checkpoint_gravar(e, caminho, "Prioridade");
+}
+
+// Restaura em `s` o estado gravado em `caminho`, inclusive o período de envelhecimento.
+// Retorna 0 em caso de sucesso e -1 em caso de erro (mensagem em stderr).
+int retomar_checkpoint(Simulacao *s, const char *caminho) {
+    LeitorCheckpoint leitor;
+    EscalaresCheckpoint esc;
+    int *itens_heap = NULL;
+
+    if (checkpoint_abrir(&leitor, caminho, "Prioridade") != 0) return -1;
+    if (checkpoint_ler(&leitor, &esc, sizeof(esc)) != 0) goto invalido;
+    if (esc.n <= 0 || esc.tamanho_heap < 0 || esc.tamanho_heap > esc.n || esc.periodo_envelhecimento < 0) {
+        checkpoint_rejeitar(caminho);
+        goto invalido;
+    }
+    s->n = esc.n;
+    s->p = (Processo *)malloc(s->n * sizeof(Processo));
+    itens_heap = (int *)malloc((esc.tamanho_heap > 0 ? esc.tamanho_heap : 1) * sizeof(int));
+    if (s->p == NULL || itens_heap == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
+        goto invalido;
+    }
+    if (checkpoint_ler(&leitor, s->p, s->n * sizeof(Processo)) != 0 || alocar_estruturas(s) != 0 ||
+        checkpoint_ler(&leitor, s->ordem_chegada, s->n * sizeof(int)) != 0 ||
+        checkpoint_ler(&leitor, itens_heap, esc.tamanho_heap * sizeof(int)) != 0 ||
+        checkpoint_ler(&leitor, &s->hist_espera, sizeof(Histograma)) != 0 ||
+        checkpoint_ler(&leitor, &s->hist_retorno, sizeof(Histograma)) != 0) {
+        goto invalido;
+    }
+    // Um arquivo com a soma certa ainda pode ser inconsistente (outra versão, outro n):
+    // todo índice restaurado precisa estar em [0, n) antes de ser usado
+    if (esc.proxima_chegada < 0 || esc.proxima_chegada > esc.n ||
+        esc.processos_finalizados < 0 || esc.processos_finalizados > esc.n ||
+        esc.atual < -1 || esc.atual >= esc.n ||
+        esc.ultimo_processo_executado < -1 || esc.ultimo_processo_executado >= esc.n ||
+        esc.maior_espera < -1 || esc.maior_espera >= esc.n ||
+        !checkpoint_indices_validos(s->ordem_chegada, s->n, s->n) ||
+        !checkpoint_indices_validos(itens_heap, esc.tamanho_heap, s->n)) {
+        checkpoint_rejeitar(caminho);
+        goto invalido;
+    }
+    heap_restaurar(&s->prontos, itens_heap, esc.tamanho_heap);
+    s->proxima_chegada = esc.proxima_chegada;
+    s->tempo_atual = esc.tempo_atual;
+    s->processos_finalizados = esc.processos_finalizados;
+    s->atual = esc.atual;
+    s->ultimo_processo_executado = esc.ultimo_processo_executado;
+    s->maior_espera = esc.maior_espera;
+    s->preempcoes_envelhecimento = (long)esc.preempcoes_envelhecimento;
+    periodo_envelhecimento = esc.periodo_envelhecimento;
+    free(itens_heap);
+    checkpoint_fechar(&leitor);
+    return 0;
+
+invalido:
+    free(itens_heap);
+    liberar_simulacao(s);
+    checkpoint_fechar(&leitor);
+    return -1;
+}
+
+int main(int argc, char *argv[]) {
+    Simulacao sim;                      // Estado da simulação (ver acima)
+    int i;
+    Rastro rastro = {0};                // -t: rastro binário da execução (desligado por padrão)
+    const char *arquivo_rastro = NULL;
+    const char *arquivo_entrada = NULL; // -e: lê os processos de um arquivo em vez do terminal
+    const char *arquivo_saida = NULL;   // -o: grava os resultados em arquivo em vez da tela
+    FormatoSaida formato_saida = SAIDA_TABELA; // -s: formato dos resultados por processo
+    int formato_definido = 0;
+    const char *arquivo_checkpoint = NULL; // -c: grava checkpoints do estado neste arquivo
+    int periodo_checkpoint = 0;         // -k: tempo simulado entre checkpoints (0: só ao interromper)
+    long long proximo_checkpoint = 0;
+    const char *arquivo_retomada = NULL; // -r: retoma a simulação de um checkpoint
+    EscritorCheckpoint checkpoint = {0};
+    long checkpoints = 0;
+    int periodo_informado = 0;
+    int status = 0; // Código de saída (1 se a escrita dos resultados falhar)
+    int opcao;
+
+    memset(&sim, 0, sizeof(sim));
+    while ((opcao = getopt(argc, argv, "e:s:o:a:t:c:k:r:")) != -1) {
+        switch (opcao) {
+        case 'e':
+            arquivo_entrada = optarg;
+            break;
+        case 's':
+            if (saida_formato(optarg, &formato_saida) != 0) {
+                fprintf(stderr, "Erro: Formato de saída inválido (use tabela, csv, binario ou resumo).\n");
+                return 1;
             }
+            formato_definido = 1;
+            break;
+        case 'o':
+            arquivo_saida = optarg;
+            break;
+        case 't':
+            arquivo_rastro = optarg;
+            break;
+        case 'a':
+            periodo_envelhecimento = atoi(optarg);
+            if (periodo_envelhecimento <= 0) {
+                fprintf(stderr, "Erro: O período de envelhecimento deve ser um inteiro positivo.\n");
+                return 1;
+            }
+            periodo_informado = 1;
+            break;
+        case 'c':
+            arquivo_checkpoint = optarg;
+            break;
+        case 'k':
+            periodo_checkpoint = atoi(optarg);
+            if (periodo_checkpoint <= 0) {
+                fprintf(stderr, "Erro: O período entre checkpoints deve ser um inteiro positivo.\n");
+                return 1;
+            }
+            break;
+        case 'r':
+            arquivo_retomada = optarg;
+            break;
+        default:
+            fprintf(stderr, "Uso: %s [-e arquivo_de_carga | -r checkpoint] [-s tabela|csv|binario|resumo] [-o arquivo_de_saida]\n"
+                            "       [-a periodo_de_envelhecimento] [-t arquivo_de_rastro] [-c checkpoint [-k periodo]]\n", argv[0]);
+            return 1;
         }
+    }
+    if (periodo_checkpoint > 0 && arquivo_checkpoint == NULL) {
+        fprintf(stderr, "Erro: A opção -k exige o arquivo de checkpoint (-c).\n");
+        return 1;
+    }
+
+    // Retomada (-r): o estado inteiro, inclusive a carga e o envelhecimento, vem do checkpoint
+    if (arquivo_retomada != NULL) {
+        int periodo_pedido = periodo_envelhecimento;
+        if (arquivo_entrada != NULL) {
+            fprintf(stderr, "Erro: Use -e ou -r, não os dois (a carga está no checkpoint).\n");
+            return 1;
+        }
+        if (retomar_checkpoint(&sim, arquivo_retomada) != 0) {
+            return 1;
+        }
+        if (periodo_informado && periodo_pedido != periodo_envelhecimento) {
+            fprintf(stderr, "Erro: O checkpoint foi gravado com período de envelhecimento %d, não %d.\n",
+                    periodo_envelhecimento, periodo_pedido);
+            liberar_simulacao(&sim);
+            return 1;
+        }
+    }
+
+    printf("## Escalonamento por Prioridade Preemptivo ##\n");
+    printf("-------------------------------------------\n");
+    printf("(Menor valor numérico indica maior prioridade)\n");
+    if (periodo_envelhecimento > 0) {
+        printf("(Envelhecimento: a prioridade efetiva melhora 1 nível a cada %d unidades de espera)\n",
+               periodo_envelhecimento);
+    }
+    printf("\n");
 
-        if (idx_candidato == -1) { // Nenhum processo pronto para executar agora
-            if (processos_finalizados == n) break; // Todos os processos já terminaram
+    if (arquivo_retomada != NULL) {
+        printf("Retomando de '%s' no tempo %d (%d de %d processos finalizados).\n",
+               arquivo_retomada, sim.tempo_atual, sim.processos_finalizados, sim.n);
+    } else {
+        // Entrada dos processos: arquivo de carga (-e) ou, na falta dele, o terminal
+        if (arquivo_entrada != NULL) {
+            sim.p = carregar_arquivo(arquivo_entrada, &sim.n);
+        } else {
+            sim.p = ler_processos_terminal(&sim.n);
+        }
+        if (sim.p == NULL) {
+            return 1;
+        }
+        for (i = 0; i < sim.n; i++) {
+            sim.p[i].restante = sim.p[i].duracao_original;
+            sim.p[i].finalizado = 0;
+            sim.p[i].inicio = -1; // Indica que ainda não começou
+            sim.p[i].termino = 0;
+            sim.p[i].espera = 0;
+            sim.p[i].retorno = 0;
+            sim.p[i].maior_espera = 0;
+        }
 
-            int proxima_chegada_minima = INT_MAX;
-            int encontrou_proximo_para_chegar = 0;
-            // Avança o tempo para a chegada do próximo processo, se CPU estiver ociosa
-            for(i=0; i<n; ++i) {
-                if(!p[i].finalizado && p[i].chegada < proxima_chegada_minima) {
-                    proxima_chegada_minima = p[i].chegada;
-                    encontrou_proximo_para_chegar = 1;
+        // Índices dos processos ordenados por chegada (desempate pelo ID) e heap de
+        // prontos ordenado por chave (prioridade) -> chegada -> ID.
+        // A ordem de chegada permite descobrir o próximo evento sem varrer todos os processos.
+        if (alocar_estruturas(&sim) != 0) {
+            free(sim.p);
+            return 1;
+        }
+        for (i = 0; i < sim.n; i++) {
+            sim.ordem_chegada[i] = i;
+        }
+        if (ordenar_por_chegada(sim.ordem_chegada, sim.n, sim.p) != 0) {
+            fprintf(stderr, "Erro: Falha na alocação de memória para a ordem de chegada!\n");
+            liberar_simulacao(&sim);
+            return 1;
+        }
+
+        sim.atual = -1;
+        sim.ultimo_processo_executado = -1;
+        sim.maior_espera = -1;
+        hist_iniciar(&sim.hist_espera);
+        hist_iniciar(&sim.hist_retorno);
+    }
+    if (arquivo_rastro != NULL && rastro_abrir(&rastro, arquivo_rastro, "Prioridade") != 0) {
+        liberar_simulacao(&sim);
+        return 1;
+    }
+
+    // Checkpoints: a cada `periodo_checkpoint` unidades de tempo simulado e, se o
+    // programa receber SIGINT ou SIGTERM, uma última vez antes de encerrar
+    if (arquivo_checkpoint != NULL) {
+        signal(SIGINT, pedir_interrupcao);
+        signal(SIGTERM, pedir_interrupcao);
+        if (periodo_checkpoint > 0) {
+            proximo_checkpoint = ((long long)sim.tempo_atual / periodo_checkpoint + 1) * periodo_checkpoint;
+        }
+    }
+
+    printf("\n--- Executando Escalonamento por Prioridade Preemptivo ---\n");
+
+    // Loop principal orientado a eventos: em vez de avançar o relógio uma unidade
+    // por vez, salta diretamente para o próximo evento (término do processo em
+    // execução, chegada de um processo que pode preemptá-lo ou, com envelhecimento,
+    // o instante em que o topo do heap passa a ter prioridade efetiva maior que a
+    // dele). Entre dois eventos o escolhido não muda.
+    while (sim.processos_finalizados < sim.n) {
+        // Checkpoint no início de uma iteração, quando o estado está completo em `sim`
+        if (arquivo_checkpoint != NULL &&
+            (interromper || (periodo_checkpoint > 0 && sim.tempo_atual >= proximo_checkpoint))) {
+            if (gravar_checkpoint(&sim, &checkpoint, arquivo_checkpoint) != 0) {
+                status = 1;
+                break;
+            }
+            checkpoints++;
+            if (interromper) {
+                printf("Simulação interrompida no tempo %d; estado gravado em '%s' (retome com -r %s).\n",
+                       sim.tempo_atual, arquivo_checkpoint, arquivo_checkpoint);
+                break;
+            }
+            proximo_checkpoint = ((long long)sim.tempo_atual / periodo_checkpoint + 1) * periodo_checkpoint;
+        }
+
+        // Processos que já chegaram entram no heap de prontos
+        while (sim.proxima_chegada < sim.n && sim.p[sim.ordem_chegada[sim.proxima_chegada]].chegada <= sim.tempo_atual) {
+            int idx = sim.ordem_chegada[sim.proxima_chegada];
+            sim.p[idx].enfileirado = sim.p[idx].chegada;
+            sim.p[idx].chave = chave_inicial(&sim.p[idx]);
+            heap_inserir_prioridade(&sim.prontos, idx);
+            RASTRAR(&rastro, sim.p[idx].chegada, sim.p[idx].id, RASTRO_CHEGADA);
+            sim.proxima_chegada++;
+        }
+
+        // Preempção: o processo em execução volta ao heap se o topo passou à sua frente
+        // (com envelhecimento, por pelo menos um nível inteiro de prioridade efetiva)
+        if (sim.atual != -1 && !heap_vazio(&sim.prontos)) {
+            int topo = heap_topo(&sim.prontos);
+            int preempta = periodo_envelhecimento > 0
+                ? sim.p[topo].chave + periodo_envelhecimento <= sim.p[sim.atual].chave
+                : comparar_prioridade(topo, sim.atual, sim.p) < 0;
+            if (preempta) {
+                if (sim.p[topo].prioridade >= sim.p[sim.atual].prioridade) {
+                    sim.preempcoes_envelhecimento++;
                 }
+                sim.p[sim.atual].enfileirado = sim.tempo_atual;
+                heap_inserir_prioridade(&sim.prontos, sim.atual);
+                RASTRAR(&rastro, sim.tempo_atual, sim.p[sim.atual].id, RASTRO_PREEMPCAO);
+                sim.atual = -1;
             }
+        }
+
+        if (sim.atual == -1) {
+            // O topo do heap é o processo pronto com a maior prioridade efetiva
+            sim.atual = heap_remover_topo_prioridade(&sim.prontos);
+            if (sim.atual == -1) { // Nenhum processo pronto para executar agora
+                if (sim.proxima_chegada == sim.n) break; // Nada mais a executar
 
-            if(encontrou_proximo_para_chegar && proxima_chegada_minima > tempo_atual) {
-                tempo_atual = proxima_chegada_minima;
-            } else {
-                tempo_atual++; // Apenas avança o tempo se não há salto definido
+                // CPU ociosa: avança o tempo diretamente para a próxima chegada
+                sim.tempo_atual = sim.p[sim.ordem_chegada[sim.proxima_chegada]].chegada;
+                sim.ultimo_processo_executado = -1; // CPU estava ociosa
+                continue;
+            }
+            // Fim de um intervalo contínuo na fila de prontos
+            if (sim.tempo_atual - sim.p[sim.atual].enfileirado > sim.p[sim.atual].maior_espera) {
+                sim.p[sim.atual].maior_espera = sim.tempo_atual - sim.p[sim.atual].enfileirado;
             }
-            ultimo_processo_executado = -1; // CPU estava ociosa
-            continue;
         }
 
-        // Se o processo selecionado é diferente do último, ou se a CPU estava ociosa
-        // e este é o primeiro a rodar, marca/atualiza seu tempo de início.
-        if (p[idx_candidato].inicio == -1) {
-            p[idx_candidato].inicio = tempo_atual;
+        // Marca o tempo de início na primeira vez que o processo é escolhido.
+        if (sim.p[sim.atual].inicio == -1) {
+            sim.p[sim.atual].inicio = sim.tempo_atual;
         }
         // Se houve preempção ou a CPU estava ociosa e um novo processo começou
-        if (ultimo_processo_executado != idx_candidato) {
-             // Poderia imprimir aqui qual processo está rodando, se quisesse um log detalhado.
-             printf("Tempo %d: Processo %d está executando.\n", tempo_atual, p[idx_candidato].id);
-             ultimo_processo_executado = idx_candidato;
+        // (o log "Tempo t: Processo x está executando." sai do rastro, ver decodificar_rastro.c)
+        if (sim.ultimo_processo_executado != sim.atual) {
+             RASTRAR(&rastro, sim.tempo_atual, sim.p[sim.atual].id, RASTRO_EXECUCAO);
+             sim.ultimo_processo_executado = sim.atual;
         }
 
+        // Próximo evento: término do processo ou a próxima chegada, o que vier antes
+        int proximo_evento = sim.tempo_atual + sim.p[sim.atual].restante;
+        if (sim.proxima_chegada < sim.n && sim.p[sim.ordem_chegada[sim.proxima_chegada]].chegada < proximo_evento) {
+            proximo_evento = sim.p[sim.ordem_chegada[sim.proxima_chegada]].chegada;
+        }
+        // Com envelhecimento, a chave do processo em execução cresce uma unidade por
+        // unidade executada; o topo o preempta quando a diferença chegar a um período
+        if (periodo_envelhecimento > 0 && !heap_vazio(&sim.prontos)) {
+            long long ultrapassa = sim.tempo_atual + sim.p[heap_topo(&sim.prontos)].chave + periodo_envelhecimento - sim.p[sim.atual].chave;
+            if (ultrapassa < proximo_evento) {
+                proximo_evento = (int)ultrapassa;
+            }
+        }
 
-        // Executa o processo por uma unidade de tempo
-        p[idx_candidato].restante--;
-        tempo_atual++;
+        // Executa o processo até o próximo evento
+        sim.p[sim.atual].restante -= proximo_evento - sim.tempo_atual;
+        if (periodo_envelhecimento > 0) {
+            sim.p[sim.atual].chave += proximo_evento - sim.tempo_atual;
+        }
+        sim.tempo_atual = proximo_evento;
 
         // Verifica se o processo terminou
-        if (p[idx_candidato].restante == 0) {
-            p[idx_candidato].termino = tempo_atual;
-            p[idx_candidato].retorno = p[idx_candidato].termino - p[idx_candidato].chegada;
-            p[idx_candidato].espera = p[idx_candidato].retorno - p[idx_candidato].duracao_original;
-            p[idx_candidato].finalizado = 1;
-            processos_finalizados++;
-            ultimo_processo_executado = -1; // Processo terminou, o próximo será uma "nova" escolha
+        if (sim.p[sim.atual].restante == 0) {
+            sim.p[sim.atual].termino = sim.tempo_atual;
+            sim.p[sim.atual].retorno = sim.p[sim.atual].termino - sim.p[sim.atual].chegada;
+            sim.p[sim.atual].espera = sim.p[sim.atual].retorno - sim.p[sim.atual].duracao_original;
+            sim.p[sim.atual].finalizado = 1;
+            sim.processos_finalizados++;
+            RASTRAR(&rastro, sim.tempo_atual, sim.p[sim.atual].id, RASTRO_TERMINO);
+            sim.ultimo_processo_executado = -1; // Processo terminou, o próximo será uma "nova" escolha
+
+            // Registra nos histogramas (médias e percentis)
+            hist_registrar(&sim.hist_espera, sim.p[sim.atual].espera);
+            hist_registrar(&sim.hist_retorno, sim.p[sim.atual].retorno);
+            if (sim.maior_espera == -1 || sim.p[sim.atual].maior_espera > sim.p[sim.maior_espera].maior_espera) {
+                sim.maior_espera = sim.atual;
+            }
+            sim.atual = -1;
+        }
+    }
+
+    checkpoint_liberar(&checkpoint);
+    if (arquivo_checkpoint != NULL && checkpoints > 0) {
+        printf("Checkpoints gravados em '%s': %ld\n", arquivo_checkpoint, checkpoints);
+    }
+    if (sim.processos_finalizados < sim.n) { // Interrompida (ou falha ao gravar o checkpoint)
+        rastro_fechar(&rastro);
+        liberar_simulacao(&sim);
+        return status;
+    }
 
-            // Acumula para cálculo das médias
-            soma_espera += p[idx_candidato].espera;
-            soma_retorno += p[idx_candidato].retorno;
+    if (arquivo_rastro != NULL) {
+        long long eventos = rastro.total;
+        if (rastro_fechar(&rastro) != 0) {
+            status = 1;
+        } else {
+            printf("Rastro de execução: %lld eventos gravados em '%s'.\n", eventos, arquivo_rastro);
         }
     }
 
     // Exibe os resultados
+    // Formato padrão: tabela para execuções pequenas, apenas o resumo para as grandes
+    if (!formato_definido) {
+        formato_saida = saida_formato_padrao(sim.n);
+    }
     printf("\n--- Resultados do Escalonamento por Prioridade Preemptivo ---\n");
-    printf("+-----+---------+---------+------------+--------+---------+--------+---------+\n");
-    printf("| %-3s | %-7s | %-7s | %-10s | %-6s | %-7s | %-6s | %-7s |\n",
-           "ID", "Chegada", "Duração", "Prioridade", "Início", "Término", "Espera", "Retorno");
-    printf("+-----+---------+---------+------------+--------+---------+--------+---------+\n");
-
-    for (i = 0; i < n; i++) {
-        printf("| %-3d | %-7d | %-7d | %-10d | %-6d | %-7d | %-6d | %-7d |\n",
-               p[i].id, p[i].chegada, p[i].duracao_original, p[i].prioridade,
-               p[i].inicio, p[i].termino, p[i].espera, p[i].retorno);
+    if (exibir_resultados(sim.p, sim.n, formato_saida, arquivo_saida) != 0) {
+        status = 1;
     }
-    printf("+-----+---------+---------+------------+--------+---------+--------+---------+\n");
 
-    if (n > 0) {
-        printf("\nTempo médio de espera: %.2f unidades de tempo\n", soma_espera / n);
-        printf("Tempo médio de retorno: %.2f unidades de tempo\n", soma_retorno / n);
+    if (sim.n > 0) {
+        printf("\nTempo médio de espera: %.2f unidades de tempo\n", hist_media(&sim.hist_espera));
+        printf("Tempo médio de retorno: %.2f unidades de tempo\n", hist_media(&sim.hist_retorno));
+        hist_exibir_percentis("espera", &sim.hist_espera);
+        hist_exibir_percentis("retorno", &sim.hist_retorno);
+        printf("Maior espera contínua na fila: %d unidades de tempo (processo %d)\n",
+               sim.p[sim.maior_espera].maior_espera, sim.p[sim.maior_espera].id);
+        if (periodo_envelhecimento > 0) {
+            printf("Preempções por envelhecimento: %ld\n", sim.preempcoes_envelhecimento);
+        }
     }
     printf("\nSimulação concluída.\n");
 
     // Liberação da memória dinâmica
-    if (p != NULL) {
-        free(p);
-        p = NULL;
-    }
+    liberar_simulacao(&sim);
 
-    return 0;
+    return status;
 }
@@ -0,0 +1,170 @@
+/*
+ * Rastro binário de execução dos escalonadores.
+ * Em vez de imprimir uma linha de texto a cada troca de processo (o que, com muitas
+ * preempções, passa a dominar o tempo da simulação), os simuladores acrescentam
+ * registros de tamanho fixo (tempo, processo, evento) a um buffer pré-alocado, que é
+ * enviado ao arquivo com write() em blocos grandes quando enche. O arquivo é só de
+ * acréscimo: cabeçalho RastroCabecalho ("ESCT", versão, nome da política) seguido de
+ * um RastroRegistro por evento, em ordem de bytes nativa. O programa
+ * decodificar_rastro.c reconstrói o log em texto ou um diagrama de Gantt.
+ *
+ * Os registros saem em ordem de tempo, exceto os de chegada: cada simulador registra a
+ * chegada com o instante real dela, no momento em que a vê (o que pode ser depois de
+ * eventos posteriores, como no SJF não preemptivo).
+ *
+ * Custo quando desligado: RASTRAR só testa `ativo` (um desvio sempre previsto); ao
+ * compilar com -DSEM_RASTRO, RASTRAR e os blocos `if (RASTRO_LIGADO(...))` desaparecem
+ * por completo do código gerado.
+ *
+ * Uso típico:
+ *     Rastro rastro = {0};  // desligado
+ *     rastro_abrir(&rastro, caminho, "Prioridade");  // opção -t
+ *     RASTRAR(&rastro, tempo, id, RASTRO_EXECUCAO);
+ *     rastro_fechar(&rastro);
+ *
+ * Uso: basta incluir este arquivo; as funções são `static inline`.
+ */
+
+#ifndef RASTRO_H
+#define RASTRO_H
+
+#include <stdio.h>   // Para fprintf
+#include <stdint.h>  // Para int32_t, uint32_t
+#include <stdlib.h>  // Para malloc, free
+#include <string.h>  // Para memcpy, strncpy
+#include <fcntl.h>   // Para open
+#include <unistd.h>  // Para write, close
+
+#define RASTRO_MAGICO "ESCT"
+#define RASTRO_VERSAO 1
+#define RASTRO_CAPACIDADE 65536 // Registros no buffer antes de cada write()
+
+// Eventos registrados. A CPU fica com o último processo de RASTRO_EXECUCAO até o
+// RASTRO_PREEMPCAO ou RASTRO_TERMINO dele (ou até outro RASTRO_EXECUCAO).
+typedef enum {
+    RASTRO_CHEGADA = 1,   // O processo entrou na fila de prontos pela primeira vez
+    RASTRO_EXECUCAO = 2,  // O processo passou a ocupar a CPU
+    RASTRO_PREEMPCAO = 3, // O processo deixou a CPU sem terminar
+    RASTRO_TERMINO = 4    // O processo terminou
+} EventoRastro;
+
+typedef struct {
+    char magico[4];   // Sempre "ESCT"
+    uint32_t versao;  // RASTRO_VERSAO
+    char politica[24]; // Nome da política que gerou o rastro (terminado em '\0')
+} RastroCabecalho;
+
+typedef struct {
+    int32_t tempo;    // Instante do evento
+    int32_t processo; // ID do processo (como exibido nas tabelas)
+    int32_t evento;   // EventoRastro
+} RastroRegistro;
+
+typedef struct {
+    int ativo;                  // 0: RASTRAR não faz nada
+    int fd;
+    RastroRegistro *registros;  // Buffer pré-alocado
+    size_t usado;
+    long long total;            // Registros gravados até agora
+    int erro;                   // 1 se alguma escrita falhou
+} Rastro;
+
+// Escreve todo o bloco no arquivo. Retorna 0 ou -1 em caso de erro.
+static inline int rastro_escrever(Rastro *r, const void *dados, size_t tamanho) {
+    const char *d = (const char *)dados;
+    while (tamanho > 0) {
+        ssize_t escritos = write(r->fd, d, tamanho);
+        if (escritos <= 0) {
+            r->erro = 1;
+            return -1;
+        }
+        d += escritos;
+        tamanho -= (size_t)escritos;
+    }
+    return 0;
+}
+
+// Cria o arquivo do rastro e liga a gravação. Retorna 0 ou -1 em caso de erro.
+static inline int rastro_abrir(Rastro *r, const char *caminho, const char *politica) {
+    RastroCabecalho cab;
+
+    r->ativo = 0;
+#ifdef SEM_RASTRO
+    (void)caminho;
+    (void)politica;
+    fprintf(stderr, "Erro: Programa compilado com -DSEM_RASTRO (sem suporte a rastro).\n");
+    return -1;
+#endif
+    r->usado = 0;
+    r->total = 0;
+    r->erro = 0;
+    r->registros = (RastroRegistro *)malloc(RASTRO_CAPACIDADE * sizeof(RastroRegistro));
+    if (r->registros == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para o rastro!\n");
+        return -1;
+    }
+    r->fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (r->fd < 0) {
+        fprintf(stderr, "Erro: Não foi possível criar o arquivo de rastro '%s'.\n", caminho);
+        free(r->registros);
+        r->registros = NULL;
+        return -1;
+    }
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magico, RASTRO_MAGICO, 4);
+    cab.versao = RASTRO_VERSAO;
+    strncpy(cab.politica, politica, sizeof(cab.politica) - 1);
+    rastro_escrever(r, &cab, sizeof(cab));
+    r->ativo = 1;
+    return 0;
+}
+
+// Envia o conteúdo do buffer ao arquivo
+static inline void rastro_descarregar(Rastro *r) {
+    if (r->usado > 0) {
+        rastro_escrever(r, r->registros, r->usado * sizeof(RastroRegistro));
+        r->usado = 0;
+    }
+}
+
+// Acrescenta um registro (use a macro RASTRAR, que evita a chamada quando desligado)
+static inline void rastro_registrar(Rastro *r, int tempo, int processo, EventoRastro evento) {
+    RastroRegistro *reg;
+    if (r->usado == RASTRO_CAPACIDADE) {
+        rastro_descarregar(r);
+    }
+    reg = &r->registros[r->usado++];
+    reg->tempo = tempo;
+    reg->processo = processo;
+    reg->evento = evento;
+    r->total++;
+}
+
+#ifdef SEM_RASTRO
+#define RASTRO_LIGADO(r) 0
+#define RASTRAR(r, tempo, processo, evento) ((void)(r))
+#else
+#define RASTRO_LIGADO(r) ((r)->ativo)
+#define RASTRAR(r, tempo, processo, evento) \
+    do { \
+        if ((r)->ativo) rastro_registrar((r), (tempo), (processo), (evento)); \
+    } while (0)
+#endif
+
+// Descarrega o que restou e fecha o arquivo (nada a fazer se o rastro está desligado).
+// Retorna 0 em caso de sucesso e -1 se alguma escrita falhou.
+static inline int rastro_fechar(Rastro *r) {
+    if (!r->ativo) return 0;
+    rastro_descarregar(r);
+    close(r->fd);
+    free(r->registros);
+    r->registros = NULL;
+    r->ativo = 0;
+    if (r->erro) {
+        fprintf(stderr, "Erro: Falha ao gravar o rastro de execução.\n");
+        return -1;
+    }
+    return 0;
+}
+
+#endif // RASTRO_H
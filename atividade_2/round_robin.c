@@ -1,25 +1,50 @@
 /* Algoritmo de Escalonamento Round Robin (RR)
  * Este programa simula o escalonamento de processos pelo critério Round Robin, onde cada processo recebe um quantum de tempo para execução.
  * O algoritmo gerencia a fila de processos prontos, alternando entre eles até que todos sejam finalizados.
+ * Com a opção -m k, simula uma fila multinível com realimentação (MLFQ) de k níveis: cada
+ * nível tem a sua fila circular e o seu quantum, quem usa a fatia inteira desce um nível,
+ * um processo que chega interrompe quem está em nível inferior e, a cada período de boost,
+ * todos voltam ao nível mais alto (o que evita a inanição). Um mapa de bits dos níveis não
+ * vazios dá o próximo nível a executar em O(1).
  * Autor: Antonio André Barcelos Chagas
  * Data: 17/05/2025
  *
  * Variáveis principais:
- * - p[MAX]: vetor de processos
+ * - p: vetor de processos (alocado dinamicamente, sem limite fixo)
  * - n: quantidade de processos  
  * - quantum: tempo máximo de execução por vez para cada processo
  * - tempo_atual: controla o tempo global de execução
  * - processos_finalizados: conta quantos processos já foram concluídos
- * - fila[MAX]: fila circular de índices dos processos prontos
- * - inicio_fila, fim_fila: controlam o início e fim da fila
- * - em_fila[MAX]: indica se o processo já está na fila
- * - soma_espera, soma_retorno: acumuladores para médias
+ * - fila_prontos: fila circular crescente de índices dos processos prontos (fila_circular.h)
+ * - ordem_chegada, proxima_chegada: processos ordenados por chegada e cursor do próximo a entrar
+ * - hist_espera, hist_retorno: histogramas de espera e retorno (médias e percentis)
+ * - niveis: número de níveis da MLFQ (0 = Round Robin simples)
+ * - rastro: rastro binário opcional da execução (-t, ver rastro.h e decodificar_rastro.c)
+ *
+ * Com a opção -f (requer -e e -q), o Round Robin é simulado em fluxo (ver fluxo.h): os
+ * processos são lidos do arquivo um a um, em ordem de chegada, e descartados ao terminar,
+ * de modo que a memória usada depende apenas de quantos processos estão no sistema.
+ *
+ * Execuções longas do Round Robin podem ser pausadas e retomadas: com -c arquivo, o
+ * estado completo da simulação (struct SimulacaoRR) é gravado a cada -k unidades de
+ * tempo simulado e ao receber SIGINT/SIGTERM; -r arquivo continua dali, com resultados
+ * idênticos aos de uma execução sem interrupção (ver checkpoint.h).
  */
 
  #include <stdio.h>
- #include <stdlib.h> // Para exit() em caso de erro grave
- 
- #define MAX 100 // Define o número máximo de processos
+ #include <stdlib.h>        // Para malloc, free, strtol
+ #include <stdint.h>        // Para uint32_t (mapa de bits dos níveis da MLFQ) e int32_t (checkpoint)
+ #include <string.h>        // Para memset
+ #include <signal.h>        // Para signal (checkpoint ao receber SIGINT/SIGTERM)
+ #include <unistd.h>        // Para getopt
+ #include "fila_circular.h" // Fila circular crescente usada como fila de prontos
+ #include "ordenacao.h"     // Radix sort das chegadas
+ #include "carga.h"         // Leitura da carga de trabalho a partir de arquivo (CSV ou binário)
+ #include "saida.h"         // Escrita dos resultados (tabela, CSV, binário ou resumo)
+ #include "histograma.h"    // Percentis de espera e retorno em memória fixa
+ #include "rastro.h"        // Rastro binário da execução (opção -t)
+ #include "fluxo.h"         // Simulação em fluxo, sem guardar a carga (opção -f)
+ #include "checkpoint.h"    // Checkpoints do estado da simulação (opções -c e -r)
  
  // Estrutura que representa um processo
  typedef struct {
@@ -32,197 +57,860 @@
      int espera;      // Tempo total de espera do processo
      int retorno;     // Tempo total de retorno (turnaround) do processo
      int finalizado;  // Flag: 1 se o processo terminou, 0 caso contrário
-     // int em_fila; // Mantido implicitamente pela lógica do array 'fila_prontos' e 'foi_para_fila'
+     int nivel;       // Nível atual na MLFQ (0 = mais alto)
+     int entrada_nivel; // Momento em que o processo entrou no nível atual (MLFQ)
  } Processo;
  
- int main() {
-     Processo p[MAX];
-     int n, i, quantum;
-     int tempo_atual = 0;
-     int processos_finalizados = 0;
-     float soma_espera = 0, soma_retorno = 0;
+ #define MLFQ_MAX_NIVEIS 32 // Um bit por nível no mapa de níveis não vazios
  
-     printf("Algoritmo de Escalonamento Round Robin\n");
-     printf("-------------------------------------\n");
+ // Um nível da MLFQ: fila própria, quantum próprio e estatísticas do nível
+ typedef struct {
+     FilaCircular fila;        // Processos prontos neste nível
+     int quantum;              // Fatia de tempo dos processos deste nível
+     long long residencia;     // Tempo total que os processos passaram no nível (na fila ou executando)
+     long long tempo_cpu;      // Tempo de CPU consumido pelos processos deste nível
+     long fatias;              // Fatias executadas neste nível
+     long trocas_contexto;     // Vezes em que a CPU passou a um processo deste nível vindo de outro
+     long rebaixamentos;       // Processos que usaram a fatia inteira e desceram para o nível seguinte
+     long terminados;          // Processos que terminaram neste nível
+ } NivelMlfq;
+ 
+ // Ordena índices de processos pela chegada; o radix sort é estável, então o empate
+ // fica com a ordem inicial dos índices, que é a dos IDs
+ #define CHAVE_CHEGADA(idx, p) ((p)[idx].chegada)
+ ORDENACAO_RADIX(ordenar_por_chegada, int, const Processo *, CHAVE_CHEGADA)
+ 
+ // Lê os processos interativamente pelo terminal.
+ // Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+ Processo *ler_processos_terminal(int *n) {
+     Processo *p;
+     int i;
  
      // Entrada do número de processos
-     printf("Informe o número de processos (max %d): ", MAX);
-     if (scanf("%d", &n) != 1) {
-         fprintf(stderr, "Erro: Entrada inválida para o número de processos.\n");
-         return 1;
+     printf("Informe o número de processos: ");
+     if (scanf("%d", n) != 1 || *n <= 0) {
+         fprintf(stderr, "Erro: Número de processos deve ser um inteiro positivo.\n");
+         return NULL;
      }
-     if (n <= 0 || n > MAX) {
-         printf("Número de processos deve ser positivo e menor ou igual a %d.\n", MAX);
-         if (n <= 0) printf("Nenhum processo para escalonar.\n");
-         return 1;
+ 
+     // Alocação dinâmica: não há mais limite fixo para o número de processos
+     p = (Processo *)malloc(*n * sizeof(Processo));
+     if (p == NULL) {
+         fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
+         return NULL;
      }
  
      // Entrada dos dados dos processos
      printf("\n--- Entrada dos Dados dos Processos ---\n");
-     for (i = 0; i < n; i++) {
+     for (i = 0; i < *n; i++) {
          p[i].id = i + 1;
          printf("Processo %d:\n", p[i].id);
          printf("  Tempo de chegada: ");
          if (scanf("%d", &p[i].chegada) != 1 || p[i].chegada < 0) {
              fprintf(stderr, "Erro: Tempo de chegada inválido para o processo %d (deve ser >= 0).\n", p[i].id);
-             return 1;
+             free(p);
+             return NULL;
          }
          printf("  Duração (burst): ");
          if (scanf("%d", &p[i].duracao) != 1 || p[i].duracao <= 0) {
              fprintf(stderr, "Erro: Duração inválida para o processo %d (deve ser > 0).\n", p[i].id);
-             return 1;
+             free(p);
+             return NULL;
          }
-         p[i].restante = p[i].duracao; // Tempo restante é inicialmente a duração total
-         p[i].inicio = -1;             // Marca que o processo ainda não iniciou (-1 é um valor sentinela)
-         p[i].finalizado = 0;          // Marca que o processo não foi finalizado
-         p[i].termino = -1;            // Inicializa tempos de resultado
-         p[i].espera = 0;
-         p[i].retorno = 0;
      }
+     return p;
+ }
  
-     // Entrada do quantum
-     printf("\nInforme o valor do quantum: ");
-     if (scanf("%d", &quantum) != 1 || quantum <= 0) {
-         fprintf(stderr, "Erro: O valor do quantum deve ser um inteiro positivo.\n");
-         return 1;
+ // Lê todos os processos de um arquivo de carga (CSV ou binário) em uma única passada.
+ // Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+ Processo *carregar_arquivo(const char *caminho, int *n) {
+     LeitorCarga carga;
+     Processo *p;
+     int i, prioridade;
+ 
+     if (carga_abrir(&carga, caminho) != 0) return NULL;
+     *n = (int)carga_quantidade(&carga);
+     if (*n <= 0) {
+         fprintf(stderr, "Erro: O arquivo '%s' não contém processos.\n", caminho);
+         carga_fechar(&carga);
+         return NULL;
+     }
+     p = (Processo *)malloc(*n * sizeof(Processo));
+     if (p == NULL) {
+         fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
+         carga_fechar(&carga);
+         return NULL;
+     }
+     for (i = 0; i < *n; i++) {
+         p[i].id = i + 1;
+         if (carga_proximo(&carga, &p[i].chegada, &p[i].duracao, &prioridade) != 1) {
+             free(p);
+             carga_fechar(&carga);
+             return NULL;
+         }
      }
+     carga_fechar(&carga);
+     printf("%d processos carregados de '%s'.\n", *n, caminho);
+     return p;
+ }
  
-     int fila_prontos[MAX]; // Fila para os índices dos processos prontos
-     int inicio_fila = 0;
-     int fim_fila = 0;
-     // Flag para controlar se um processo já foi adicionado à fila de prontos (para evitar duplicatas desnecessárias)
-     // e para ajudar na lógica de CPU ociosa.
-     // 0 = não considerado para fila ainda, 1 = já entrou no sistema de fila/execução.
-     int entrou_no_sistema[MAX] = {0};
+ // Escreve o resultado de cada processo no formato escolhido (ver saida.h).
+ // Retorna 0 em caso de sucesso e -1 em caso de erro.
+ int exibir_resultados(const Processo *p, int n, FormatoSaida formato, const char *arquivo_saida) {
+     EscritorResultados saida;
+     LinhaResultado linha = {0}; // Colunas opcionais não usadas ficam zeradas
+     int i;
+
+     if (saida_abrir(&saida, formato, arquivo_saida, 0) != 0) return -1;
+     saida_cabecalho(&saida, n);
+     if (formato != SAIDA_RESUMO) {
+         for (i = 0; i < n; i++) {
+             linha.id = p[i].id;
+             linha.chegada = p[i].chegada;
+             linha.duracao = p[i].duracao;
+             linha.prioridade = 0;
+             linha.inicio = p[i].inicio;
+             linha.termino = p[i].termino;
+             linha.espera = p[i].espera;
+             linha.retorno = p[i].retorno;
+             saida_linha(&saida, &linha);
+         }
+     }
+     saida_rodape(&saida);
+     return saida_fechar(&saida);
+ }
+
+ // Escreve a linha de resultado de cada processo no momento em que ele termina (-f)
+ void escrever_conclusao(const ConclusaoFluxo *c, void *contexto) {
+     EscritorResultados *saida = (EscritorResultados *)contexto;
+     LinhaResultado linha = {0}; // Colunas opcionais não usadas ficam zeradas
+     linha.id = c->id;
+     linha.chegada = c->chegada;
+     linha.duracao = c->duracao;
+     linha.inicio = c->inicio;
+     linha.termino = c->termino;
+     linha.espera = c->espera;
+     linha.retorno = c->retorno;
+     saida_linha(saida, &linha);
+ }
+
+ // Simula a carga do arquivo em fluxo (-f): cada chegada é lida e entregue ao simulador,
+ // e cada resultado é escrito (na ordem de término) e descartado.
+ // Retorna 0 em caso de sucesso e 1 em caso de erro.
+ int simular_em_fluxo(const char *arquivo_entrada, int quantum, FormatoSaida formato, int formato_definido,
+                      const char *arquivo_saida, Rastro *rastro) {
+     LeitorCarga carga;
+     SimuladorFluxo simulador;
+     EscritorResultados saida;
+     long n;
+     int status = 0;
+
+     if (carga_abrir(&carga, arquivo_entrada) != 0) return 1;
+     n = carga_quantidade(&carga);
+     if (fluxo_criar(&simulador, quantum) != 0) {
+         fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+         carga_fechar(&carga);
+         return 1;
+     }
+     if (!formato_definido) {
+         formato = saida_formato_padrao(n);
+     }
+     printf("%ld processos no arquivo '%s' (simulação em fluxo).\n", n, arquivo_entrada);
+     printf("\n--- Resultados do Escalonamento Round Robin (Quantum: %d, em ordem de término) ---\n", quantum);
+     if (saida_abrir(&saida, formato, arquivo_saida, 0) != 0) {
+         fluxo_destruir(&simulador);
+         carga_fechar(&carga);
+         return 1;
+     }
+     saida_cabecalho(&saida, n);
+     if (formato != SAIDA_RESUMO) {
+         simulador.ao_concluir = escrever_conclusao;
+         simulador.contexto = &saida;
+     }
+     simulador.rastro = RASTRO_LIGADO(rastro) ? rastro : NULL;
+
+     if (fluxo_alimentar(&simulador, &carga) != 0 || fluxo_encerrar(&simulador) != 0) {
+         status = 1;
+     }
+     saida_rodape(&saida);
+     if (saida_fechar(&saida) != 0) {
+         status = 1;
+     }
+     carga_fechar(&carga);
+
+     if (status == 0 && simulador.concluidos > 0) {
+         printf("\nTempo médio de espera: %.2f unidades de tempo\n", hist_media(&simulador.hist_espera));
+         printf("Tempo médio de retorno: %.2f unidades de tempo\n", hist_media(&simulador.hist_retorno));
+         hist_exibir_percentis("espera", &simulador.hist_espera);
+         hist_exibir_percentis("retorno", &simulador.hist_retorno);
+         printf("Trocas de contexto: %ld\n", simulador.trocas_contexto);
+         printf("Maior número de processos no sistema: %lld\n", simulador.maior_presenca);
+     }
+     fluxo_destruir(&simulador);
+     return status;
+ }
+
+ // Coloca o processo idx no fim da fila do nível informado, marcando o nível como não vazio
+ int mlfq_inserir(NivelMlfq *niveis, uint32_t *nao_vazios, Processo *p, int idx, int nivel, int entrada) {
+     if (fila_inserir(&niveis[nivel].fila, idx) != 0) return -1;
+     p[idx].nivel = nivel;
+     p[idx].entrada_nivel = entrada;
+     *nao_vazios |= (uint32_t)1 << nivel;
+     return 0;
+ }
  
-     printf("\n--- Executando Escalonamento Round Robin ---\n");
+ // Simula a MLFQ com k níveis sobre os processos já ordenados por chegada.
+ // Retorna o número de boosts ou -1 se faltar memória.
+ long executar_mlfq(Processo *p, int n, const int *ordem_chegada, NivelMlfq *niveis, int k,
+                    int periodo_boost, Histograma *hist_espera, Histograma *hist_retorno, Rastro *rastro) {
+     uint32_t nao_vazios = 0; // Bit j ligado = fila do nível j tem processos
+     int tempo_atual = 0, proxima_chegada = 0, processos_finalizados = 0, ultimo = -1;
+     int proximo_boost = periodo_boost;
+     long boosts = 0;
+     int j;
  
-     // Loop principal: executa enquanto houver processos não finalizados
      while (processos_finalizados < n) {
-         int processos_adicionados_nesta_iteracao = 0;
+         int idx, nivel, fatia, fim;
  
-         // 1. Adicionar processos à fila de prontos
-         // Adiciona processos que chegaram (chegada <= tempo_atual) e ainda não entraram no sistema.
-         for (i = 0; i < n; i++) {
-             if (!p[i].finalizado && !entrou_no_sistema[i] && p[i].chegada <= tempo_atual) {
-                 if (fim_fila < MAX) { // Verifica se a fila tem espaço (segurança)
-                     fila_prontos[fim_fila++] = i;
-                     entrou_no_sistema[i] = 1; // Marca que o processo entrou no sistema de enfileiramento
-                     processos_adicionados_nesta_iteracao++;
-                 } else {
-                     fprintf(stderr, "Erro: Fila de prontos excedeu a capacidade máxima. Aumente MAX.\n");
-                     return 1;
+         // Chegadas entram no nível mais alto (a residência conta desde a chegada)
+         while (proxima_chegada < n && p[ordem_chegada[proxima_chegada]].chegada <= tempo_atual) {
+             idx = ordem_chegada[proxima_chegada];
+             if (mlfq_inserir(niveis, &nao_vazios, p, idx, 0, p[idx].chegada) != 0) return -1;
+             RASTRAR(rastro, p[idx].chegada, p[idx].id, RASTRO_CHEGADA);
+             proxima_chegada++;
+         }
+ 
+         // Boost periódico: todos os processos dos níveis inferiores voltam ao nível 0
+         if (periodo_boost > 0 && tempo_atual >= proximo_boost) {
+             for (j = 1; j < k; j++) {
+                 while (!fila_vazia(&niveis[j].fila)) {
+                     idx = fila_remover(&niveis[j].fila);
+                     niveis[j].residencia += tempo_atual - p[idx].entrada_nivel;
+                     if (mlfq_inserir(niveis, &nao_vazios, p, idx, 0, tempo_atual) != 0) return -1;
                  }
              }
+             nao_vazios &= 1u;
+             boosts++;
+             proximo_boost = (tempo_atual / periodo_boost + 1) * periodo_boost;
          }
  
-         // 2. Se a fila de prontos estiver vazia (CPU Ociosa)
-         if (inicio_fila == fim_fila) {
-             if (processos_finalizados == n) { // Todos os processos terminaram
-                 break;
+         // CPU ociosa: salta para a próxima chegada
+         if (nao_vazios == 0) {
+             tempo_atual = p[ordem_chegada[proxima_chegada]].chegada;
+             continue;
+         }
+ 
+         // O nível não vazio mais alto é o bit ligado menos significativo
+         nivel = __builtin_ctz(nao_vazios);
+         idx = fila_remover(&niveis[nivel].fila);
+         if (fila_vazia(&niveis[nivel].fila)) {
+             nao_vazios &= ~((uint32_t)1 << nivel);
+         }
+         if (p[idx].inicio == -1) {
+             p[idx].inicio = tempo_atual;
+         }
+         if (idx != ultimo) {
+             niveis[nivel].trocas_contexto++;
+             if (ultimo != -1 && !p[ultimo].finalizado) {
+                 RASTRAR(rastro, tempo_atual, p[ultimo].id, RASTRO_PREEMPCAO);
              }
+             RASTRAR(rastro, tempo_atual, p[idx].id, RASTRO_EXECUCAO);
+             ultimo = idx;
+         }
  
-             // Encontrar o menor tempo de chegada futuro de um processo que ainda não entrou no sistema
-             int menor_chegada_futura = -1;
-             for (i = 0; i < n; i++) {
-                 if (!p[i].finalizado && !entrou_no_sistema[i]) {
-                     if (menor_chegada_futura == -1 || p[i].chegada < menor_chegada_futura) {
-                         menor_chegada_futura = p[i].chegada;
-                     }
-                 }
+         // Executa o quantum do nível, o tempo restante ou, fora do nível 0, até uma
+         // chegada (que tem prioridade maior e interrompe a fatia)
+         fatia = p[idx].restante < niveis[nivel].quantum ? p[idx].restante : niveis[nivel].quantum;
+         fim = tempo_atual + fatia;
+         if (nivel > 0 && proxima_chegada < n && p[ordem_chegada[proxima_chegada]].chegada < fim) {
+             fim = p[ordem_chegada[proxima_chegada]].chegada;
+         }
+         p[idx].restante -= fim - tempo_atual;
+         niveis[nivel].tempo_cpu += fim - tempo_atual;
+         niveis[nivel].fatias++;
+         fatia = fim - tempo_atual;
+         tempo_atual = fim;
+ 
+         if (p[idx].restante == 0) {
+             p[idx].finalizado = 1;
+             p[idx].termino = tempo_atual;
+             p[idx].retorno = p[idx].termino - p[idx].chegada;
+             p[idx].espera = p[idx].retorno - p[idx].duracao;
+             niveis[nivel].residencia += tempo_atual - p[idx].entrada_nivel;
+             niveis[nivel].terminados++;
+             processos_finalizados++;
+             RASTRAR(rastro, tempo_atual, p[idx].id, RASTRO_TERMINO);
+             hist_registrar(hist_espera, p[idx].espera);
+             hist_registrar(hist_retorno, p[idx].retorno);
+         } else if (fatia == niveis[nivel].quantum && nivel < k - 1) {
+             // Usou a fatia inteira: desce um nível
+             niveis[nivel].residencia += tempo_atual - p[idx].entrada_nivel;
+             niveis[nivel].rebaixamentos++;
+             if (mlfq_inserir(niveis, &nao_vazios, p, idx, nivel + 1, tempo_atual) != 0) return -1;
+         } else {
+             // Último nível ou interrompido por uma chegada: volta ao fim da fila do mesmo nível
+             if (fila_inserir(&niveis[nivel].fila, idx) != 0) return -1;
+             nao_vazios |= (uint32_t)1 << nivel;
+         }
+     }
+     return boosts;
+ }
+ 
+ // Exibe as estatísticas de cada nível da MLFQ
+ void exibir_niveis(const NivelMlfq *niveis, int k, long boosts) {
+     int j;
+     printf("\n--- Níveis da MLFQ ---\n");
+     printf("+-------+---------+--------------+--------------+------------+------------+---------------+------------+\n");
+     printf("| %-5s | %-7s | %-12s | %-12s | %-10s | %-10s | %-13s | %-10s |\n", "Nível", "Quantum",
+            "Residência", "Tempo de CPU", "Fatias", "Trocas", "Rebaixamentos", "Terminados");
+     printf("+-------+---------+--------------+--------------+------------+------------+---------------+------------+\n");
+     for (j = 0; j < k; j++) {
+         printf("| %-5d | %-7d | %12lld | %12lld | %10ld | %10ld | %13ld | %10ld |\n", j, niveis[j].quantum,
+                niveis[j].residencia, niveis[j].tempo_cpu, niveis[j].fatias, niveis[j].trocas_contexto,
+                niveis[j].rebaixamentos, niveis[j].terminados);
+     }
+     printf("+-------+---------+--------------+--------------+------------+------------+---------------+------------+\n");
+     printf("Boosts: %ld\n", boosts);
+ }
+ 
+ // Estado completo da simulação Round Robin: tudo o que o laço principal lê e altera
+ // entre duas fatias. É o que um checkpoint (-c) grava e o que a retomada (-r) restaura
+ // (junto com o quantum).
+ typedef struct {
+     int n;                     // Quantidade de processos
+     Processo *p;               // Vetor de processos
+     int *ordem_chegada;        // Índices dos processos ordenados por chegada
+     int proxima_chegada;       // Cursor em ordem_chegada: próximo processo a entrar no sistema
+     FilaCircular fila_prontos; // Fila circular (crescente) dos índices dos processos prontos
+     int tempo_atual;
+     int processos_finalizados;
+     int ultimo_executado;      // Processo da fatia anterior (para o rastro)
+     Histograma hist_espera, hist_retorno; // Distribuição das esperas e dos retornos (média e percentis)
+ } SimulacaoRR;
+
+ // Campos escalares de SimulacaoRR, com largura fixa, como gravados no checkpoint
+ typedef struct {
+     int32_t n, quantum, proxima_chegada, tamanho_fila;
+     int32_t tempo_atual, processos_finalizados, ultimo_executado;
+ } EscalaresCheckpoint;
+
+ // Pedido de interrupção (SIGINT/SIGTERM com -c): grava um checkpoint e encerra
+ static volatile sig_atomic_t interromper = 0;
+
+ void pedir_interrupcao(int sinal) {
+     (void)sinal;
+     interromper = 1;
+ }
+
+ // Aloca o vetor de ordem de chegada e a fila de prontos. Retorna 0 ou -1 se faltar memória.
+ int alocar_estruturas(SimulacaoRR *s) {
+     s->ordem_chegada = (int *)malloc(s->n * sizeof(int));
+     if (s->ordem_chegada == NULL || fila_criar(&s->fila_prontos) != 0) {
+         fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+         free(s->ordem_chegada);
+         s->ordem_chegada = NULL;
+         return -1;
+     }
+     return 0;
+ }
+
+ void liberar_simulacao(SimulacaoRR *s) {
+     if (s->ordem_chegada != NULL) {
+         fila_destruir(&s->fila_prontos);
+     }
+     free(s->ordem_chegada);
+     free(s->p);
+     s->ordem_chegada = NULL;
+     s->p = NULL;
+ }
+
+ // Grava o estado da simulação em `caminho` (ver checkpoint.h). A fila de prontos vai
+ // em dois trechos (antes e depois de dar a volta no vetor circular), do primeiro ao
+ // último. Retorna 0 em caso de sucesso e -1 em caso de erro.
+ int gravar_checkpoint(const SimulacaoRR *s, int quantum, EscritorCheckpoint *e, const char *caminho) {
+     const FilaCircular *f = &s->fila_prontos;
+     EscalaresCheckpoint esc;
+     size_t ate_o_fim = f->capacidade - f->inicio; // Elementos antes de dar a volta
+
+     memset(&esc, 0, sizeof(esc));
+     esc.n = s->n;
+     esc.quantum = quantum;
+     esc.proxima_chegada = s->proxima_chegada;
+     esc.tamanho_fila = (int32_t)f->tamanho;
+     esc.tempo_atual = s->tempo_atual;
+     esc.processos_finalizados = s->processos_finalizados;
+     esc.ultimo_executado = s->ultimo_executado;
+     if (ate_o_fim > f->tamanho) ate_o_fim = f->tamanho;
+
+     checkpoint_iniciar(e);
+     checkpoint_secao(e, &esc, sizeof(esc));
+     checkpoint_secao(e, s->p, s->n * sizeof(Processo));
+     checkpoint_secao(e, s->ordem_chegada, s->n * sizeof(int));
+     checkpoint_secao(e, f->itens + f->inicio, ate_o_fim * sizeof(int));
+     checkpoint_secao(e, f->itens, (f->tamanho - ate_o_fim) * sizeof(int));
+     checkpoint_secao(e, &s->hist_espera, sizeof(Histograma));
+     checkpoint_secao(e, &s->hist_retorno, sizeof(Histograma));
+     return checkpoint_gravar(e, caminho, "Round Robin");
+ }
+
+ // Restaura em `s` (e em *quantum) o estado gravado em `caminho`.
+ // Retorna 0 em caso de sucesso e -1 em caso de erro (mensagem em stderr).
+ int retomar_checkpoint(SimulacaoRR *s, int *quantum, const char *caminho) {
+     LeitorCheckpoint leitor;
+     EscalaresCheckpoint esc;
+     int *itens_fila = NULL;
+     long long trecho;
+     int k;
+
+     if (checkpoint_abrir(&leitor, caminho, "Round Robin") != 0) return -1;
+     if (checkpoint_ler(&leitor, &esc, sizeof(esc)) != 0) goto invalido;
+     if (esc.n <= 0 || esc.quantum <= 0 || esc.tamanho_fila < 0 || esc.tamanho_fila > esc.n) {
+         checkpoint_rejeitar(caminho);
+         goto invalido;
+     }
+     s->n = esc.n;
+     s->p = (Processo *)malloc(s->n * sizeof(Processo));
+     itens_fila = (int *)malloc((esc.tamanho_fila > 0 ? esc.tamanho_fila : 1) * sizeof(int));
+     if (s->p == NULL || itens_fila == NULL) {
+         fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
+         goto invalido;
+     }
+     if (checkpoint_ler(&leitor, s->p, s->n * sizeof(Processo)) != 0 || alocar_estruturas(s) != 0 ||
+         checkpoint_ler(&leitor, s->ordem_chegada, s->n * sizeof(int)) != 0) {
+         goto invalido;
+     }
+     // Os dois trechos da fila somam tamanho_fila itens
+     trecho = checkpoint_tamanho_secao(&leitor);
+     if (trecho < 0 || trecho > esc.tamanho_fila * (long long)sizeof(int) ||
+         checkpoint_ler(&leitor, itens_fila, (size_t)trecho) != 0 ||
+         checkpoint_ler(&leitor, (char *)itens_fila + trecho, esc.tamanho_fila * sizeof(int) - (size_t)trecho) != 0 ||
+         checkpoint_ler(&leitor, &s->hist_espera, sizeof(Histograma)) != 0 ||
+         checkpoint_ler(&leitor, &s->hist_retorno, sizeof(Histograma)) != 0) {
+         goto invalido;
+     }
+     // Um arquivo com a soma certa ainda pode ser inconsistente (outra versão, outro n):
+     // todo índice restaurado precisa estar em [0, n) antes de ser usado
+     if (esc.proxima_chegada < 0 || esc.proxima_chegada > esc.n ||
+         esc.processos_finalizados < 0 || esc.processos_finalizados > esc.n ||
+         esc.ultimo_executado < -1 || esc.ultimo_executado >= esc.n ||
+         !checkpoint_indices_validos(s->ordem_chegada, s->n, s->n) ||
+         !checkpoint_indices_validos(itens_fila, esc.tamanho_fila, s->n)) {
+         checkpoint_rejeitar(caminho);
+         goto invalido;
+     }
+     for (k = 0; k < esc.tamanho_fila; k++) {
+         if (fila_inserir(&s->fila_prontos, itens_fila[k]) != 0) {
+             fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+             goto invalido;
+         }
+     }
+     *quantum = esc.quantum;
+     s->proxima_chegada = esc.proxima_chegada;
+     s->tempo_atual = esc.tempo_atual;
+     s->processos_finalizados = esc.processos_finalizados;
+     s->ultimo_executado = esc.ultimo_executado;
+     free(itens_fila);
+     checkpoint_fechar(&leitor);
+     return 0;
+
+ invalido:
+     free(itens_fila);
+     liberar_simulacao(s);
+     checkpoint_fechar(&leitor);
+     return -1;
+ }
+
+ int main(int argc, char *argv[]) {
+     SimulacaoRR sim;               // Estado da simulação (ver acima)
+     int i, quantum = 0;
+     const char *arquivo_entrada = NULL; // -e: lê os processos de um arquivo em vez do terminal
+     const char *arquivo_saida = NULL;   // -o: grava os resultados em arquivo em vez da tela
+     FormatoSaida formato_saida = SAIDA_TABELA; // -s: formato dos resultados por processo
+     int formato_definido = 0;
+     int niveis_mlfq = 0;           // -m: número de níveis da MLFQ (0 = Round Robin simples)
+     const char *lista_quanta = NULL; // -q: quantum, ou quanta dos níveis separados por vírgula
+     int periodo_boost = -1;        // -b: período do boost da MLFQ (0 desativa)
+     NivelMlfq niveis[MLFQ_MAX_NIVEIS];
+     long boosts = 0;
+     Rastro rastro = {0};           // -t: rastro binário da execução (desligado por padrão)
+     const char *arquivo_rastro = NULL;
+     int em_fluxo = 0;              // -f: simula sem guardar a carga na memória
+     const char *arquivo_checkpoint = NULL; // -c: grava checkpoints do estado neste arquivo
+     int periodo_checkpoint = 0;    // -k: tempo simulado entre checkpoints (0: só ao interromper)
+     long long proximo_checkpoint = 0;
+     const char *arquivo_retomada = NULL; // -r: retoma a simulação de um checkpoint
+     EscritorCheckpoint checkpoint = {0};
+     long checkpoints = 0;
+     int status = 0; // Código de saída (1 se a escrita dos resultados falhar)
+     int opcao;
+ 
+     memset(&sim, 0, sizeof(sim));
+     while ((opcao = getopt(argc, argv, "e:q:s:o:m:b:t:fc:k:r:")) != -1) {
+         switch (opcao) {
+         case 'e':
+             arquivo_entrada = optarg;
+             break;
+         case 'q':
+             lista_quanta = optarg;
+             quantum = atoi(optarg);
+             if (quantum <= 0) {
+                 fprintf(stderr, "Erro: O valor do quantum deve ser um inteiro positivo.\n");
+                 return 1;
              }
+             break;
+         case 's':
+             if (saida_formato(optarg, &formato_saida) != 0) {
+                 fprintf(stderr, "Erro: Formato de saída inválido (use tabela, csv, binario ou resumo).\n");
+                 return 1;
+             }
+             formato_definido = 1;
+             break;
+         case 'o':
+             arquivo_saida = optarg;
+             break;
+         case 'm':
+             niveis_mlfq = atoi(optarg);
+             if (niveis_mlfq <= 0 || niveis_mlfq > MLFQ_MAX_NIVEIS) {
+                 fprintf(stderr, "Erro: O número de níveis da MLFQ deve estar entre 1 e %d.\n", MLFQ_MAX_NIVEIS);
+                 return 1;
+             }
+             break;
+         case 't':
+             arquivo_rastro = optarg;
+             break;
+         case 'f':
+             em_fluxo = 1;
+             break;
+         case 'c':
+             arquivo_checkpoint = optarg;
+             break;
+         case 'k':
+             periodo_checkpoint = atoi(optarg);
+             if (periodo_checkpoint <= 0) {
+                 fprintf(stderr, "Erro: O período entre checkpoints deve ser um inteiro positivo.\n");
+                 return 1;
+             }
+             break;
+         case 'r':
+             arquivo_retomada = optarg;
+             break;
+         case 'b':
+             periodo_boost = atoi(optarg);
+             if (periodo_boost < 0) {
+                 fprintf(stderr, "Erro: O período de boost deve ser >= 0 (0 desativa o boost).\n");
+                 return 1;
+             }
+             break;
+         default:
+             fprintf(stderr, "Uso: %s [-e arquivo_de_carga [-f] | -r checkpoint] [-q quantum[,quantum...]] [-m niveis] [-b periodo_boost]\n"
+                             "       [-s tabela|csv|binario|resumo] [-o arquivo_de_saida] [-t arquivo_de_rastro] [-c checkpoint [-k periodo]]\n", argv[0]);
+             return 1;
+         }
+     }
  
-             if (menor_chegada_futura != -1) { // Se existe um processo futuro para chegar
-                 if (tempo_atual < menor_chegada_futura) {
-                     tempo_atual = menor_chegada_futura; // Avança o tempo para a chegada do próximo
-                 } else {
-                      // Processo já deveria ter chegado ou está chegando agora, mas não entrou no sistema
-                      // O loop de adição no início da próxima iteração do while deve pegá-lo.
-                      // Apenas incrementa o tempo para garantir progresso se não houver avanço para chegada futura.
-                      tempo_atual++;
-                 }
+     if (periodo_checkpoint > 0 && arquivo_checkpoint == NULL) {
+         fprintf(stderr, "Erro: A opção -k exige o arquivo de checkpoint (-c).\n");
+         return 1;
+     }
+     if ((arquivo_checkpoint != NULL || arquivo_retomada != NULL) && (niveis_mlfq > 0 || em_fluxo)) {
+         fprintf(stderr, "Erro: Checkpoints (-c, -r) estão disponíveis apenas no Round Robin simples (sem -m e -f).\n");
+         return 1;
+     }
+ 
+     if (niveis_mlfq > 0) {
+         printf("Algoritmo de Escalonamento MLFQ (Fila Multinível com Realimentação)\n");
+         printf("-------------------------------------------------------------------\n");
+     } else {
+         printf("Algoritmo de Escalonamento Round Robin\n");
+         printf("-------------------------------------\n");
+     }
+
+     if (em_fluxo) {
+         if (arquivo_entrada == NULL || quantum == 0 || niveis_mlfq > 0) {
+             fprintf(stderr, "Erro: A simulação em fluxo (-f) exige um arquivo de carga (-e) e o quantum (-q), e não se aplica à MLFQ.\n");
+             return 1;
+         }
+         if (arquivo_rastro != NULL && rastro_abrir(&rastro, arquivo_rastro, "Round Robin") != 0) {
+             return 1;
+         }
+         status = simular_em_fluxo(arquivo_entrada, quantum, formato_saida, formato_definido, arquivo_saida, &rastro);
+         if (arquivo_rastro != NULL) {
+             long long eventos = rastro.total;
+             if (rastro_fechar(&rastro) != 0) {
+                 status = 1;
              } else {
-                 // Fila vazia, nenhum processo novo para entrar no sistema, mas nem todos finalizaram.
-                 // Isso pode ocorrer se todos os processos restantes já estão "entrou_no_sistema = 1"
-                 // mas não estão na fila (o que seria um erro de estado) ou se o loop de finalização
-                 // não está correto. Por segurança, apenas avança o tempo se há trabalho a fazer.
-                 if (processos_finalizados < n) {
-                     tempo_atual++;
-                 } else {
-                     break; // Segurança, loop principal deve pegar
-                 }
+                 printf("Rastro de execução: %lld eventos gravados em '%s'.\n", eventos, arquivo_rastro);
+             }
+         }
+         printf("\nSimulação Round Robin concluída.\n");
+         return status;
+     }
+ 
+     if (arquivo_retomada != NULL) {
+         // Retomada (-r): o estado inteiro, inclusive a carga e o quantum, vem do checkpoint
+         int quantum_pedido = quantum;
+         if (arquivo_entrada != NULL) {
+             fprintf(stderr, "Erro: Use -e ou -r, não os dois (a carga está no checkpoint).\n");
+             return 1;
+         }
+         if (retomar_checkpoint(&sim, &quantum, arquivo_retomada) != 0) {
+             return 1;
+         }
+         if (quantum_pedido != 0 && quantum_pedido != quantum) {
+             fprintf(stderr, "Erro: O checkpoint foi gravado com quantum %d, não %d.\n", quantum, quantum_pedido);
+             liberar_simulacao(&sim);
+             return 1;
+         }
+         printf("Retomando de '%s' no tempo %d (%d de %d processos finalizados).\n",
+                arquivo_retomada, sim.tempo_atual, sim.processos_finalizados, sim.n);
+     } else {
+         // Entrada dos processos: arquivo de carga (-e) ou, na falta dele, o terminal
+         if (arquivo_entrada != NULL) {
+             sim.p = carregar_arquivo(arquivo_entrada, &sim.n);
+         } else {
+             sim.p = ler_processos_terminal(&sim.n);
+         }
+         if (sim.p == NULL) {
+             return 1;
+         }
+         for (i = 0; i < sim.n; i++) {
+             sim.p[i].restante = sim.p[i].duracao; // Tempo restante é inicialmente a duração total
+             sim.p[i].inicio = -1;             // Marca que o processo ainda não iniciou (-1 é um valor sentinela)
+             sim.p[i].finalizado = 0;          // Marca que o processo não foi finalizado
+             sim.p[i].termino = -1;            // Inicializa tempos de resultado
+             sim.p[i].espera = 0;
+             sim.p[i].retorno = 0;
+         }
+ 
+         // Entrada do quantum (se não foi informado com -q)
+         if (quantum == 0) {
+             printf("\nInforme o valor do quantum: ");
+             if (scanf("%d", &quantum) != 1 || quantum <= 0) {
+                 fprintf(stderr, "Erro: O valor do quantum deve ser um inteiro positivo.\n");
+                 free(sim.p);
+                 return 1;
              }
+         }
+ 
+         if (alocar_estruturas(&sim) != 0) {
+             free(sim.p);
+             return 1;
+         }
+ 
+         // Ordena os índices por chegada: os processos entram no sistema seguindo um
+         // cursor sobre essa ordem, sem varrer todos os processos a cada iteração.
+         for (i = 0; i < sim.n; i++) {
+             sim.ordem_chegada[i] = i;
+         }
+         if (ordenar_por_chegada(sim.ordem_chegada, sim.n, sim.p) != 0) {
+             fprintf(stderr, "Erro: Falha na alocação de memória para a ordem de chegada!\n");
+             liberar_simulacao(&sim);
+             return 1;
+         }
+ 
+         sim.ultimo_executado = -1;
+         hist_iniciar(&sim.hist_espera);
+         hist_iniciar(&sim.hist_retorno);
+     }
+     if (arquivo_rastro != NULL && rastro_abrir(&rastro, arquivo_rastro, niveis_mlfq > 0 ? "MLFQ" : "Round Robin") != 0) {
+         liberar_simulacao(&sim);
+         return 1;
+     }
+ 
+     // Checkpoints: a cada `periodo_checkpoint` unidades de tempo simulado e, se o
+     // programa receber SIGINT ou SIGTERM, uma última vez antes de encerrar
+     if (arquivo_checkpoint != NULL) {
+         signal(SIGINT, pedir_interrupcao);
+         signal(SIGTERM, pedir_interrupcao);
+         if (periodo_checkpoint > 0) {
+             proximo_checkpoint = ((long long)sim.tempo_atual / periodo_checkpoint + 1) * periodo_checkpoint;
+         }
+     }
+ 
+     if (niveis_mlfq > 0) {
+         // Quanta dos níveis: os informados em -q (separados por vírgula) e, para os demais
+         // níveis, o dobro do quantum do nível anterior
+         const char *cursor = lista_quanta;
+         for (i = 0; i < niveis_mlfq; i++) {
+             char *fim_numero;
+             long valor = cursor != NULL ? strtol(cursor, &fim_numero, 10) : 0;
+             if (cursor != NULL && fim_numero != cursor && valor > 0) {
+                 niveis[i].quantum = (int)valor;
+                 cursor = *fim_numero == ',' ? fim_numero + 1 : NULL;
+             } else {
+                 niveis[i].quantum = i == 0 ? quantum : 2 * niveis[i - 1].quantum;
+                 cursor = NULL;
+             }
+             niveis[i].residencia = niveis[i].tempo_cpu = 0;
+             niveis[i].fatias = niveis[i].trocas_contexto = niveis[i].rebaixamentos = niveis[i].terminados = 0;
+             if (fila_criar(&niveis[i].fila) != 0) {
+                 fprintf(stderr, "Erro: Falha na alocação de memória para as filas da MLFQ!\n");
+                 while (i-- > 0) fila_destruir(&niveis[i].fila);
+                 liberar_simulacao(&sim);
+                 rastro_fechar(&rastro);
+                 return 1;
+             }
+         }
+         if (periodo_boost < 0) {
+             periodo_boost = 10 * niveis[niveis_mlfq - 1].quantum; // Padrão: 10 fatias do último nível
+         }
+ 
+         printf("\n--- Executando Escalonamento MLFQ (%d níveis, boost a cada %d) ---\n", niveis_mlfq, periodo_boost);
+         boosts = executar_mlfq(sim.p, sim.n, sim.ordem_chegada, niveis, niveis_mlfq, periodo_boost, &sim.hist_espera, &sim.hist_retorno, &rastro);
+         for (i = 0; i < niveis_mlfq; i++) {
+             fila_destruir(&niveis[i].fila);
+         }
+         if (boosts < 0) {
+             fprintf(stderr, "Erro: Falha na alocação de memória para as filas da MLFQ!\n");
+             liberar_simulacao(&sim);
+             rastro_fechar(&rastro);
+             return 1;
+         }
+         sim.processos_finalizados = sim.n;
+     } else {
+         printf("\n--- Executando Escalonamento Round Robin ---\n");
+     }
+ 
+     // Loop principal: executa enquanto houver processos não finalizados
+     while (sim.processos_finalizados < sim.n) {
+         // 0. Checkpoint no início de uma iteração, quando o estado está completo em `sim`
+         if (arquivo_checkpoint != NULL &&
+             (interromper || (periodo_checkpoint > 0 && sim.tempo_atual >= proximo_checkpoint))) {
+             if (gravar_checkpoint(&sim, quantum, &checkpoint, arquivo_checkpoint) != 0) {
+                 status = 1;
+                 break;
+             }
+             checkpoints++;
+             if (interromper) {
+                 printf("Simulação interrompida no tempo %d; estado gravado em '%s' (retome com -r %s).\n",
+                        sim.tempo_atual, arquivo_checkpoint, arquivo_checkpoint);
+                 break;
+             }
+             proximo_checkpoint = ((long long)sim.tempo_atual / periodo_checkpoint + 1) * periodo_checkpoint;
+         }
+ 
+         // 1. Adicionar à fila de prontos os processos que chegaram (chegada <= tempo_atual),
+         // em ordem de chegada. Cada processo passa pelo cursor uma única vez.
+         while (sim.proxima_chegada < sim.n && sim.p[sim.ordem_chegada[sim.proxima_chegada]].chegada <= sim.tempo_atual) {
+             if (fila_inserir(&sim.fila_prontos, sim.ordem_chegada[sim.proxima_chegada]) != 0) {
+                 fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+                 liberar_simulacao(&sim);
+                 rastro_fechar(&rastro);
+                 return 1;
+             }
+             RASTRAR(&rastro, sim.p[sim.ordem_chegada[sim.proxima_chegada]].chegada, sim.p[sim.ordem_chegada[sim.proxima_chegada]].id, RASTRO_CHEGADA);
+             sim.proxima_chegada++;
+         }
+ 
+         // 2. Se a fila de prontos estiver vazia (CPU Ociosa), avança o tempo
+         // diretamente para a chegada do próximo processo.
+         if (fila_vazia(&sim.fila_prontos)) {
+             if (sim.proxima_chegada == sim.n) { // Nenhum processo por chegar: todos terminaram
+                 break;
+             }
+             sim.tempo_atual = sim.p[sim.ordem_chegada[sim.proxima_chegada]].chegada;
              continue; // Volta ao início do loop para reavaliar com o novo tempo_atual
          }
  
          // 3. Retirar o próximo processo da fila de prontos
-         int idx_processo_atual = fila_prontos[inicio_fila++];
+         int idx_processo_atual = fila_remover(&sim.fila_prontos);
  
          // Registrar o tempo de início se for a primeira vez que o processo executa
-         if (p[idx_processo_atual].inicio == -1) {
-             p[idx_processo_atual].inicio = tempo_atual;
+         if (sim.p[idx_processo_atual].inicio == -1) {
+             sim.p[idx_processo_atual].inicio = sim.tempo_atual;
+         }
+         if (idx_processo_atual != sim.ultimo_executado) {
+             if (sim.ultimo_executado != -1 && !sim.p[sim.ultimo_executado].finalizado) {
+                 RASTRAR(&rastro, sim.tempo_atual, sim.p[sim.ultimo_executado].id, RASTRO_PREEMPCAO);
+             }
+             RASTRAR(&rastro, sim.tempo_atual, sim.p[idx_processo_atual].id, RASTRO_EXECUCAO);
+             sim.ultimo_executado = idx_processo_atual;
          }
  
          // 4. Executar o processo pelo quantum ou pelo tempo restante
          int tempo_de_execucao_nesta_fatia;
-         if (p[idx_processo_atual].restante <= quantum) {
-             tempo_de_execucao_nesta_fatia = p[idx_processo_atual].restante;
-             p[idx_processo_atual].finalizado = 1; // Processo terminará nesta fatia
+         if (sim.p[idx_processo_atual].restante <= quantum) {
+             tempo_de_execucao_nesta_fatia = sim.p[idx_processo_atual].restante;
+             sim.p[idx_processo_atual].finalizado = 1; // Processo terminará nesta fatia
          } else {
              tempo_de_execucao_nesta_fatia = quantum;
          }
  
-         tempo_atual += tempo_de_execucao_nesta_fatia;
-         p[idx_processo_atual].restante -= tempo_de_execucao_nesta_fatia;
+         sim.tempo_atual += tempo_de_execucao_nesta_fatia;
+         sim.p[idx_processo_atual].restante -= tempo_de_execucao_nesta_fatia;
  
-         // 5. Adicionar processos que chegaram DURANTE a execução desta fatia
-         // (Esta lógica já está no início do loop while, que é mais abrangente
-         // e será executada na próxima iteração, considerando o novo tempo_atual.
-         // Repetir aqui seria redundante se a estrutura do loop principal estiver correta.)
-         // A estrutura atual (adicionar no início do while, depois pegar da fila) é comum.
+         // 5. Os processos que chegaram DURANTE esta fatia são adicionados no início
+         // da próxima iteração, depois do re-enfileiramento do processo atual.
  
          // 6. Lidar com o processo após sua fatia de tempo
-         if (p[idx_processo_atual].finalizado) {
-             p[idx_processo_atual].termino = tempo_atual;
-             p[idx_processo_atual].retorno = p[idx_processo_atual].termino - p[idx_processo_atual].chegada;
-             p[idx_processo_atual].espera = p[idx_processo_atual].retorno - p[idx_processo_atual].duracao;
-             processos_finalizados++;
+         if (sim.p[idx_processo_atual].finalizado) {
+             sim.p[idx_processo_atual].termino = sim.tempo_atual;
+             sim.p[idx_processo_atual].retorno = sim.p[idx_processo_atual].termino - sim.p[idx_processo_atual].chegada;
+             sim.p[idx_processo_atual].espera = sim.p[idx_processo_atual].retorno - sim.p[idx_processo_atual].duracao;
+             sim.processos_finalizados++;
+             RASTRAR(&rastro, sim.tempo_atual, sim.p[idx_processo_atual].id, RASTRO_TERMINO);
+ 
+             // Registra nos histogramas (médias e percentis)
+             hist_registrar(&sim.hist_espera, sim.p[idx_processo_atual].espera);
+             hist_registrar(&sim.hist_retorno, sim.p[idx_processo_atual].retorno);
+         } else if (fila_inserir(&sim.fila_prontos, idx_processo_atual) != 0) {
+             // Processo não terminou: volta para o fim da fila de prontos
+             fprintf(stderr, "Erro: Falha na alocação de memória ao re-enfileirar o processo %d.\n",
+                     sim.p[idx_processo_atual].id);
+             liberar_simulacao(&sim);
+             rastro_fechar(&rastro);
+             return 1;
+         }
+     }
+ 
+     checkpoint_liberar(&checkpoint);
+     if (arquivo_checkpoint != NULL && checkpoints > 0) {
+         printf("Checkpoints gravados em '%s': %ld\n", arquivo_checkpoint, checkpoints);
+     }
+     if (sim.processos_finalizados < sim.n) { // Interrompida (ou falha ao gravar o checkpoint)
+         rastro_fechar(&rastro);
+         liberar_simulacao(&sim);
+         return status;
+     }
+ 
+     if (arquivo_rastro != NULL) {
+         long long eventos = rastro.total;
+         if (rastro_fechar(&rastro) != 0) {
+             status = 1;
          } else {
-             // Processo não terminou, precisa voltar para o fim da fila de prontos.
-             // Adicionar processos que chegaram *antes* de re-enfileirar o atual é importante
-             // para manter a ordem correta de chegada.
-             // O loop no início do while já cuida da adição de novos processos.
-             // Agora, re-enfileiramos o processo atual.
-             if (fim_fila < MAX) {
-                  fila_prontos[fim_fila++] = idx_processo_atual;
-             } else {
-                 fprintf(stderr, "Erro: Fila de prontos excedeu a capacidade máxima ao tentar re-enfileirar. Aumente MAX.\n");
-                 return 1;
-             }
+             printf("Rastro de execução: %lld eventos gravados em '%s'.\n", eventos, arquivo_rastro);
          }
      }
  
      // 7. Exibir os resultados
-     printf("\n--- Resultados do Escalonamento Round Robin (Quantum: %d) ---\n", quantum);
-     printf("+-----+---------+---------+--------+---------+--------+---------+\n");
-     printf("| %-3s | %-7s | %-7s | %-6s | %-7s | %-6s | %-7s |\n",
-            "ID", "Chegada", "Duração", "Início", "Término", "Espera", "Retorno");
-     printf("+-----+---------+---------+--------+---------+--------+---------+\n");
- 
-     for (i = 0; i < n; i++) {
-         printf("| %-3d | %-7d | %-7d | %-6d | %-7d | %-6d | %-7d |\n",
-                p[i].id, p[i].chegada, p[i].duracao,
-                p[i].inicio, p[i].termino, p[i].espera, p[i].retorno);
-         soma_espera += p[i].espera;
-         soma_retorno += p[i].retorno;
+     // Formato padrão: tabela para execuções pequenas, apenas o resumo para as grandes
+     if (!formato_definido) {
+         formato_saida = saida_formato_padrao(sim.n);
+     }
+     if (niveis_mlfq > 0) {
+         printf("\n--- Resultados do Escalonamento MLFQ (%d níveis) ---\n", niveis_mlfq);
+     } else {
+         printf("\n--- Resultados do Escalonamento Round Robin (Quantum: %d) ---\n", quantum);
+     }
+     if (exibir_resultados(sim.p, sim.n, formato_saida, arquivo_saida) != 0) {
+         status = 1;
      }
-     printf("+-----+---------+---------+--------+---------+--------+---------+\n");
  
-     if (n > 0) {
-         printf("\nTempo médio de espera: %.2f unidades de tempo\n", soma_espera / n);
-         printf("Tempo médio de retorno: %.2f unidades de tempo\n", soma_retorno / n);
+     if (sim.n > 0) {
+         printf("\nTempo médio de espera: %.2f unidades de tempo\n", hist_media(&sim.hist_espera));
+         printf("Tempo médio de retorno: %.2f unidades de tempo\n", hist_media(&sim.hist_retorno));
+         hist_exibir_percentis("espera", &sim.hist_espera);
+         hist_exibir_percentis("retorno", &sim.hist_retorno);
+     }
+     if (niveis_mlfq > 0) {
+         exibir_niveis(niveis, niveis_mlfq, boosts);
+         printf("\nSimulação MLFQ concluída.\n");
+     } else {
+         printf("\nSimulação Round Robin concluída.\n");
      }
-     printf("\nSimulação Round Robin concluída.\n");
  
-     return 0;
+     // Liberação da memória dinâmica
+     liberar_simulacao(&sim);
+ 
+     return status;
  }
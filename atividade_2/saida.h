@@ -0,0 +1,296 @@
+/*
+ * Escrita dos resultados por processo com buffer próprio.
+ * As linhas são montadas em um buffer grande e enviadas com write() em blocos
+ * sequenciais, em vez de um printf por processo. Formatos disponíveis:
+ * - tabela:  a tabela ASCII de sempre (padrão para execuções pequenas)
+ * - csv:     id,chegada,duracao[,prioridade],inicio,termino,espera,retorno[,maior_espera][,desvio]
+ * - binario: cabeçalho SaidaCabecalho ("ESCR", versão, quantidade) seguido de um
+ *            SaidaRegistro (oito int32 em ordem nativa) por processo
+ * - resumo:  nenhuma linha por processo; apenas as médias impressas pelo programa
+ *            (padrão quando há mais de SAIDA_LIMITE_TABELA processos)
+ * As colunas opcionais "maior espera" (maior intervalo contínuo na fila de prontos) e
+ * "desvio" (maior distância do serviço justo, no escalonador justo) são ligadas com
+ * com_maior_espera = 1 e com_desvio = 1 após saida_abrir e só aparecem na tabela e no
+ * CSV; o registro binário não muda.
+ *
+ * Uso típico:
+ *     EscritorResultados saida;
+ *     saida_abrir(&saida, formato, caminho_ou_NULL, com_prioridade);
+ *     saida_cabecalho(&saida, n);
+ *     for (...) saida_linha(&saida, &linha);
+ *     saida_rodape(&saida);
+ *     saida_fechar(&saida);
+ */
+
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include <stdio.h>     // Para fflush, snprintf, fprintf
+#include <stdint.h>    // Para int32_t, uint32_t, uint64_t
+#include <stdlib.h>    // Para malloc, free
+#include <string.h>    // Para memcpy, strcmp
+#include <fcntl.h>     // Para open
+#include <unistd.h>    // Para write, close
+
+#define SAIDA_TAMANHO_BUFFER (1 << 20)  // Blocos de 1 MiB por chamada a write()
+#define SAIDA_LIMITE_TABELA 1000        // Acima disso o padrão passa a ser o resumo
+#define SAIDA_MAGICO "ESCR"
+#define SAIDA_VERSAO 1
+
+typedef enum {
+    SAIDA_TABELA,
+    SAIDA_CSV,
+    SAIDA_BINARIO,
+    SAIDA_RESUMO
+} FormatoSaida;
+
+// Resultado de um processo, como exibido na tabela
+typedef struct {
+    int id, chegada, duracao, prioridade, inicio, termino, espera, retorno;
+    int maior_espera;     // Só escrito quando com_maior_espera = 1
+    int desvio;           // Só escrito quando com_desvio = 1
+} LinhaResultado;
+
+// Cabeçalho e registro do formato binário
+typedef struct {
+    char magico[4];       // Sempre "ESCR"
+    uint32_t versao;      // SAIDA_VERSAO
+    uint64_t quantidade;  // Número de registros que seguem o cabeçalho
+} SaidaCabecalho;
+
+typedef struct {
+    int32_t id, chegada, duracao, prioridade, inicio, termino, espera, retorno;
+} SaidaRegistro;
+
+typedef struct {
+    int fd;               // Destino (STDOUT_FILENO ou arquivo aberto por saida_abrir)
+    FormatoSaida formato;
+    int com_prioridade;   // 1 se a coluna de prioridade deve ser escrita
+    int com_maior_espera; // 1 se a coluna de maior espera deve ser escrita (tabela e CSV)
+    int com_desvio;       // 1 se a coluna de desvio deve ser escrita (tabela e CSV)
+    char *buffer;
+    size_t usado;         // Bytes ocupados no buffer
+    int erro;             // 1 se alguma escrita falhou
+} EscritorResultados;
+
+// Converte o nome do formato (-s) em FormatoSaida. Retorna 0 ou -1 se desconhecido.
+static inline int saida_formato(const char *nome, FormatoSaida *formato) {
+    if (strcmp(nome, "tabela") == 0) *formato = SAIDA_TABELA;
+    else if (strcmp(nome, "csv") == 0) *formato = SAIDA_CSV;
+    else if (strcmp(nome, "binario") == 0) *formato = SAIDA_BINARIO;
+    else if (strcmp(nome, "resumo") == 0) *formato = SAIDA_RESUMO;
+    else return -1;
+    return 0;
+}
+
+// Formato usado quando -s não é informado: tabela para execuções pequenas, resumo para as grandes
+static inline FormatoSaida saida_formato_padrao(long n) {
+    return n <= SAIDA_LIMITE_TABELA ? SAIDA_TABELA : SAIDA_RESUMO;
+}
+
+// Envia o conteúdo do buffer ao destino
+static inline void saida_descarregar(EscritorResultados *e) {
+    size_t enviado = 0;
+    if (e->fd == STDOUT_FILENO) {
+        fflush(stdout); // Mantém a ordem em relação ao que já foi impresso com printf
+    }
+    while (enviado < e->usado) {
+        ssize_t r = write(e->fd, e->buffer + enviado, e->usado - enviado);
+        if (r <= 0) {
+            e->erro = 1;
+            break;
+        }
+        enviado += (size_t)r;
+    }
+    e->usado = 0;
+}
+
+// Garante espaço para mais `tamanho` bytes no buffer
+static inline char *saida_reservar(EscritorResultados *e, size_t tamanho) {
+    if (e->usado + tamanho > SAIDA_TAMANHO_BUFFER) {
+        saida_descarregar(e);
+    }
+    return e->buffer + e->usado;
+}
+
+static inline void saida_texto(EscritorResultados *e, const char *texto) {
+    size_t tamanho = strlen(texto);
+    memcpy(saida_reservar(e, tamanho), texto, tamanho);
+    e->usado += tamanho;
+}
+
+// Escreve um inteiro em decimal (sem passar por printf)
+static inline char *saida_inteiro(char *destino, int valor) {
+    char digitos[12];
+    int k = 0;
+    unsigned int v = valor < 0 ? 0u - (unsigned int)valor : (unsigned int)valor;
+    if (valor < 0) *destino++ = '-';
+    do {
+        digitos[k++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    while (k > 0) *destino++ = digitos[--k];
+    return destino;
+}
+
+// Abre o escritor. caminho == NULL escreve na saída padrão.
+// Retorna 0 em caso de sucesso e -1 em caso de erro (mensagem em stderr).
+static inline int saida_abrir(EscritorResultados *e, FormatoSaida formato, const char *caminho, int com_prioridade) {
+    e->formato = formato;
+    e->com_prioridade = com_prioridade;
+    e->com_maior_espera = 0;
+    e->com_desvio = 0;
+    e->usado = 0;
+    e->erro = 0;
+    e->fd = STDOUT_FILENO;
+    e->buffer = (char *)malloc(SAIDA_TAMANHO_BUFFER);
+    if (e->buffer == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para o buffer de saída!\n");
+        return -1;
+    }
+    if (caminho != NULL) {
+        e->fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (e->fd < 0) {
+            fprintf(stderr, "Erro: Não foi possível criar o arquivo de saída '%s'.\n", caminho);
+            free(e->buffer);
+            e->buffer = NULL;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static inline void saida_separador(EscritorResultados *e) {
+    saida_texto(e, e->com_prioridade
+        ? "+-----+---------+---------+------------+--------+---------+--------+---------+"
+        : "+-----+---------+---------+--------+---------+--------+---------+");
+    if (e->com_maior_espera) saida_texto(e, "--------------+");
+    if (e->com_desvio) saida_texto(e, "--------+");
+    saida_texto(e, "\n");
+}
+
+// Escreve o cabeçalho do formato escolhido (n = quantidade de linhas que virão)
+static inline void saida_cabecalho(EscritorResultados *e, long n) {
+    char linha[160];
+    switch (e->formato) {
+    case SAIDA_TABELA:
+        saida_separador(e);
+        if (e->com_prioridade) {
+            snprintf(linha, sizeof(linha), "| %-3s | %-7s | %-7s | %-10s | %-6s | %-7s | %-6s | %-7s |\n",
+                     "ID", "Chegada", "Duração", "Prioridade", "Início", "Término", "Espera", "Retorno");
+        } else {
+            snprintf(linha, sizeof(linha), "| %-3s | %-7s | %-7s | %-6s | %-7s | %-6s | %-7s |\n",
+                     "ID", "Chegada", "Duração", "Início", "Término", "Espera", "Retorno");
+        }
+        if (e->com_maior_espera) {
+            snprintf(linha + strlen(linha) - 1, 32, " %-12s |\n", "Maior espera");
+        }
+        if (e->com_desvio) {
+            snprintf(linha + strlen(linha) - 1, 32, " %-6s |\n", "Desvio");
+        }
+        saida_texto(e, linha);
+        saida_separador(e);
+        break;
+    case SAIDA_CSV:
+        saida_texto(e, e->com_prioridade ? "id,chegada,duracao,prioridade,inicio,termino,espera,retorno"
+                                         : "id,chegada,duracao,inicio,termino,espera,retorno");
+        if (e->com_maior_espera) saida_texto(e, ",maior_espera");
+        if (e->com_desvio) saida_texto(e, ",desvio");
+        saida_texto(e, "\n");
+        break;
+    case SAIDA_BINARIO: {
+        SaidaCabecalho cab;
+        memcpy(cab.magico, SAIDA_MAGICO, 4);
+        cab.versao = SAIDA_VERSAO;
+        cab.quantidade = (uint64_t)n;
+        memcpy(saida_reservar(e, sizeof(cab)), &cab, sizeof(cab));
+        e->usado += sizeof(cab);
+        break;
+    }
+    case SAIDA_RESUMO:
+        break;
+    }
+}
+
+// Escreve o resultado de um processo
+static inline void saida_linha(EscritorResultados *e, const LinhaResultado *l) {
+    switch (e->formato) {
+    case SAIDA_TABELA: {
+        char *d = saida_reservar(e, 192);
+        int escritos = e->com_prioridade
+            ? snprintf(d, 192, "| %-3d | %-7d | %-7d | %-10d | %-6d | %-7d | %-6d | %-7d |\n",
+                       l->id, l->chegada, l->duracao, l->prioridade, l->inicio, l->termino, l->espera, l->retorno)
+            : snprintf(d, 192, "| %-3d | %-7d | %-7d | %-6d | %-7d | %-6d | %-7d |\n",
+                       l->id, l->chegada, l->duracao, l->inicio, l->termino, l->espera, l->retorno);
+        if (e->com_maior_espera) {
+            escritos += snprintf(d + escritos - 1, 32, " %-12d |\n", l->maior_espera) - 1;
+        }
+        if (e->com_desvio) {
+            escritos += snprintf(d + escritos - 1, 32, " %-6d |\n", l->desvio) - 1;
+        }
+        e->usado += (size_t)escritos;
+        break;
+    }
+    case SAIDA_CSV: {
+        char *inicio = saida_reservar(e, 10 * 12);
+        char *d = inicio;
+        d = saida_inteiro(d, l->id); *d++ = ',';
+        d = saida_inteiro(d, l->chegada); *d++ = ',';
+        d = saida_inteiro(d, l->duracao); *d++ = ',';
+        if (e->com_prioridade) {
+            d = saida_inteiro(d, l->prioridade); *d++ = ',';
+        }
+        d = saida_inteiro(d, l->inicio); *d++ = ',';
+        d = saida_inteiro(d, l->termino); *d++ = ',';
+        d = saida_inteiro(d, l->espera); *d++ = ',';
+        d = saida_inteiro(d, l->retorno);
+        if (e->com_maior_espera) {
+            *d++ = ',';
+            d = saida_inteiro(d, l->maior_espera);
+        }
+        if (e->com_desvio) {
+            *d++ = ',';
+            d = saida_inteiro(d, l->desvio);
+        }
+        *d++ = '\n';
+        e->usado += (size_t)(d - inicio);
+        break;
+    }
+    case SAIDA_BINARIO: {
+        SaidaRegistro r;
+        r.id = l->id; r.chegada = l->chegada; r.duracao = l->duracao;
+        r.prioridade = e->com_prioridade ? l->prioridade : -1;
+        r.inicio = l->inicio; r.termino = l->termino; r.espera = l->espera; r.retorno = l->retorno;
+        memcpy(saida_reservar(e, sizeof(r)), &r, sizeof(r));
+        e->usado += sizeof(r);
+        break;
+    }
+    case SAIDA_RESUMO:
+        break;
+    }
+}
+
+// Encerra a tabela (linha de fechamento); nos demais formatos não faz nada
+static inline void saida_rodape(EscritorResultados *e) {
+    if (e->formato == SAIDA_TABELA) {
+        saida_separador(e);
+    }
+}
+
+// Descarrega o que restou no buffer e fecha o destino.
+// Retorna 0 em caso de sucesso e -1 se alguma escrita falhou.
+static inline int saida_fechar(EscritorResultados *e) {
+    saida_descarregar(e);
+    if (e->fd != STDOUT_FILENO) {
+        close(e->fd);
+    }
+    free(e->buffer);
+    e->buffer = NULL;
+    if (e->erro) {
+        fprintf(stderr, "Erro: Falha ao escrever os resultados.\n");
+        return -1;
+    }
+    return 0;
+}
+
+#endif // SAIDA_H
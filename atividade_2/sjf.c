@@ -2,6 +2,10 @@
  * Algoritmo de Escalonamento SJF (Shortest Job First)
  * Este programa simula o escalonamento de processos pelo critério do menor trabalho primeiro (menor duração).
  * Cada processo possui tempo de chegada, duração, e o programa calcula tempos de início, término, espera e retorno.
+ * Os processos prontos ficam em um heap indexado (heap.h), então cada decisão custa O(log n).
+ * Com a opção -p, simula a versão preemptiva, SRTF (Shortest Remaining Time First): o heap
+ * é ordenado pelo tempo restante e a escolha só é refeita a cada chegada ou término, o que
+ * dá custo O((n + preempções) log n).
  * Autor: Antonio André Barcelos Chagas
  * Data: 17/05/2025
  *
@@ -9,18 +13,28 @@
  * - p[MAX]: vetor de processos
  * - n: quantidade de processos
  * - tempo_atual: controla o tempo global de execução
+ * - preemptivo: 1 no modo SRTF (-p)
  * - processos_finalizados: conta quantos processos já foram concluídos
- * - soma_espera, soma_retorno: acumuladores para médias
+ * - hist_espera, hist_retorno: histogramas de espera e retorno (médias e percentis)
+ * - rastro: rastro binário opcional da execução (-t, ver rastro.h e decodificar_rastro.c)
  */
 
  #include <stdio.h>
  #include <stdlib.h> // Para malloc, free, exit
+ #include <unistd.h> // Para getopt
+ #include "heap.h"   // Heap indexado usado como fila de prontos
+ #include "ordenacao.h" // Radix sort das chegadas e comparadores especializados
+ #include "carga.h"  // Leitura da carga de trabalho a partir de arquivo (CSV ou binário)
+ #include "saida.h"  // Escrita dos resultados (tabela, CSV, binário ou resumo)
+ #include "histograma.h" // Percentis de espera e retorno em memória fixa
+ #include "rastro.h"     // Rastro binário da execução (opção -t)
  
  // Estrutura que representa um processo
  typedef struct {
      int id;         // Identificador do processo
      int chegada;    // Tempo de chegada do processo
      int duracao;    // Duração (tempo de execução) do processo
+     int restante;   // Tempo de execução que ainda falta (modo SRTF)
      int inicio;     // Momento em que o processo começa a executar
      int termino;    // Momento em que o processo termina
      int espera;     // Tempo de espera na fila
@@ -28,120 +42,312 @@
      int finalizado; // Indica se o processo já foi finalizado (1) ou não (0)
  } Processo;
  
- int main() {
-     Processo *p = NULL; // Ponteiro para o array de processos (para alocação dinâmica)
-     int n, i;
-     int tempo_atual = 0;
-     int processos_finalizados = 0;
-     float soma_espera = 0, soma_retorno = 0;
+ // Ordena índices de processos pela chegada; o radix sort é estável, então o empate
+ // fica com a ordem inicial dos índices, que é a dos IDs
+ #define CHAVE_CHEGADA(idx, p) ((p)[idx].chegada)
+ ORDENACAO_RADIX(ordenar_por_chegada, int, const Processo *, CHAVE_CHEGADA)
+ 
+ // Ordem do heap de prontos: menor duração, depois menor chegada, depois menor ID
+ COMPARADOR_PROCESSOS(comparar_duracao, Processo, duracao)
+ 
+ // Ordem do heap de prontos no SRTF: menor tempo restante, depois menor chegada, depois menor ID
+ COMPARADOR_PROCESSOS(comparar_restante, Processo, restante)
  
-     printf("Algoritmo de Escalonamento SJF (Shortest Job First) Não Preemptivo\n");
-     printf("------------------------------------------------------------------\n");
+ // Operações do heap com o comparador expandido em tempo de compilação (heap.h)
+ HEAP_ESPECIALIZAR(duracao, comparar_duracao)
+ HEAP_ESPECIALIZAR(restante, comparar_restante)
+ 
+ // Lê os processos interativamente pelo terminal.
+ // Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+ Processo *ler_processos_terminal(int *n) {
+     Processo *p;
+     int i;
  
      // Entrada do número de processos
      printf("Informe o número de processos: ");
-     if (scanf("%d", &n) != 1 || n <= 0) {
+     if (scanf("%d", n) != 1 || *n <= 0) {
          fprintf(stderr, "Erro: Número de processos deve ser um inteiro positivo.\n");
-         return 1;
+         return NULL;
      }
  
      // --- ALOCAÇÃO DINÂMICA DE MEMÓRIA ---
-     p = (Processo *)malloc(n * sizeof(Processo));
+     p = (Processo *)malloc(*n * sizeof(Processo));
      if (p == NULL) {
          fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
-         return 1;
+         return NULL;
      }
      // --- FIM DA ALOCAÇÃO DINÂMICA ---
  
      // Entrada dos dados dos processos
      printf("\n--- Entrada dos Dados dos Processos ---\n");
-     for (i = 0; i < n; i++) {
+     for (i = 0; i < *n; i++) {
          p[i].id = i + 1;
          printf("Processo %d:\n", p[i].id);
          printf("  Tempo de chegada: ");
          if (scanf("%d", &p[i].chegada) != 1 || p[i].chegada < 0) {
              fprintf(stderr, "Erro: Tempo de chegada inválido para o processo %d (deve ser >= 0).\n", p[i].id);
              free(p); // Libera memória alocada antes de sair
-             return 1;
+             return NULL;
          }
          printf("  Duração (burst): ");
          if (scanf("%d", &p[i].duracao) != 1 || p[i].duracao <= 0) {
              fprintf(stderr, "Erro: Duração inválida para o processo %d (deve ser > 0).\n", p[i].id);
              free(p); // Libera memória alocada antes de sair
+             return NULL;
+         }
+     }
+     return p;
+ }
+ 
+ // Lê todos os processos de um arquivo de carga (CSV ou binário) em uma única passada.
+ // Retorna o vetor alocado (e o tamanho em *n) ou NULL em caso de erro.
+ Processo *carregar_arquivo(const char *caminho, int *n) {
+     LeitorCarga carga;
+     Processo *p;
+     int i, prioridade;
+ 
+     if (carga_abrir(&carga, caminho) != 0) return NULL;
+     *n = (int)carga_quantidade(&carga);
+     if (*n <= 0) {
+         fprintf(stderr, "Erro: O arquivo '%s' não contém processos.\n", caminho);
+         carga_fechar(&carga);
+         return NULL;
+     }
+     p = (Processo *)malloc(*n * sizeof(Processo));
+     if (p == NULL) {
+         fprintf(stderr, "Erro: Falha na alocação de memória para os processos!\n");
+         carga_fechar(&carga);
+         return NULL;
+     }
+     for (i = 0; i < *n; i++) {
+         p[i].id = i + 1;
+         if (carga_proximo(&carga, &p[i].chegada, &p[i].duracao, &prioridade) != 1) {
+             free(p);
+             carga_fechar(&carga);
+             return NULL;
+         }
+     }
+     carga_fechar(&carga);
+     printf("%d processos carregados de '%s'.\n", *n, caminho);
+     return p;
+ }
+ 
+ // Escreve o resultado de cada processo no formato escolhido (ver saida.h).
+ // Retorna 0 em caso de sucesso e -1 em caso de erro.
+ int exibir_resultados(const Processo *p, int n, FormatoSaida formato, const char *arquivo_saida) {
+     EscritorResultados saida;
+     LinhaResultado linha = {0}; // Colunas opcionais não usadas ficam zeradas
+     int i;
+
+     if (saida_abrir(&saida, formato, arquivo_saida, 0) != 0) return -1;
+     saida_cabecalho(&saida, n);
+     if (formato != SAIDA_RESUMO) {
+         for (i = 0; i < n; i++) {
+             linha.id = p[i].id;
+             linha.chegada = p[i].chegada;
+             linha.duracao = p[i].duracao;
+             linha.prioridade = 0;
+             linha.inicio = p[i].inicio;
+             linha.termino = p[i].termino;
+             linha.espera = p[i].espera;
+             linha.retorno = p[i].retorno;
+             saida_linha(&saida, &linha);
+         }
+     }
+     saida_rodape(&saida);
+     return saida_fechar(&saida);
+ }
+
+ // Saída por falha de alocação depois de abrir o rastro: libera o que já foi alocado e
+ // fecha o rastro (se aberto), para não deixar o buffer nem um arquivo incompleto aberto
+ static int abortar_simulacao(Processo *p, int *ordem_chegada, Rastro *rastro) {
+     free(ordem_chegada);
+     free(p);
+     rastro_fechar(rastro);
+     return 1;
+ }
+
+ int main(int argc, char *argv[]) {
+     Processo *p = NULL; // Ponteiro para o array de processos (para alocação dinâmica)
+     int n, i;
+     int tempo_atual = 0;
+     int processos_finalizados = 0;
+     Histograma hist_espera, hist_retorno; // Distribuição das esperas e dos retornos (média e percentis)
+     int *ordem_chegada = NULL; // Índices dos processos ordenados por chegada
+     int proxima_chegada = 0;   // Cursor em ordem_chegada: próximo processo a chegar
+     HeapIndexado prontos;      // Processos que chegaram e ainda não executaram
+     const char *arquivo_entrada = NULL; // -e: lê os processos de um arquivo em vez do terminal
+     const char *arquivo_saida = NULL;   // -o: grava os resultados em arquivo em vez da tela
+     FormatoSaida formato_saida = SAIDA_TABELA; // -s: formato dos resultados por processo
+     int formato_definido = 0;
+     int preemptivo = 0; // -p: SRTF (SJF preemptivo)
+     const char *nome_algoritmo = "SJF Não Preemptivo";
+     int ultimo_executado = -1; // Processo que ocupava a CPU (SRTF), ou -1 após término/ociosidade
+     long preempcoes = 0;       // Vezes em que um processo foi interrompido por outro mais curto
+     Rastro rastro = {0};       // -t: rastro binário da execução (desligado por padrão)
+     const char *arquivo_rastro = NULL;
+     int status = 0; // Código de saída (1 se a escrita dos resultados falhar)
+     int opcao;
+ 
+     while ((opcao = getopt(argc, argv, "e:s:o:pt:")) != -1) {
+         switch (opcao) {
+         case 'e':
+             arquivo_entrada = optarg;
+             break;
+         case 's':
+             if (saida_formato(optarg, &formato_saida) != 0) {
+                 fprintf(stderr, "Erro: Formato de saída inválido (use tabela, csv, binario ou resumo).\n");
+                 return 1;
+             }
+             formato_definido = 1;
+             break;
+         case 'o':
+             arquivo_saida = optarg;
+             break;
+         case 't':
+             arquivo_rastro = optarg;
+             break;
+         case 'p':
+             preemptivo = 1;
+             nome_algoritmo = "SRTF (SJF Preemptivo)";
+             break;
+         default:
+             fprintf(stderr, "Uso: %s [-e arquivo_de_carga] [-s tabela|csv|binario|resumo] [-o arquivo_de_saida] [-p] [-t arquivo_de_rastro]\n", argv[0]);
              return 1;
          }
+     }
+ 
+     if (preemptivo) {
+         printf("Algoritmo de Escalonamento SRTF (Shortest Remaining Time First)\n");
+         printf("---------------------------------------------------------------\n");
+     } else {
+         printf("Algoritmo de Escalonamento SJF (Shortest Job First) Não Preemptivo\n");
+         printf("------------------------------------------------------------------\n");
+     }
+ 
+     // Entrada dos processos: arquivo de carga (-e) ou, na falta dele, o terminal
+     if (arquivo_entrada != NULL) {
+         p = carregar_arquivo(arquivo_entrada, &n);
+     } else {
+         p = ler_processos_terminal(&n);
+     }
+     if (p == NULL) {
+         return 1;
+     }
+     if (arquivo_rastro != NULL && rastro_abrir(&rastro, arquivo_rastro, preemptivo ? "SRTF" : "SJF") != 0) {
+         free(p);
+         return 1;
+     }
+     for (i = 0; i < n; i++) {
          p[i].finalizado = 0; // Inicialmente, nenhum processo está finalizado
+         p[i].restante = p[i].duracao;
          p[i].inicio = -1;    // Inicializa para indicar que não começou
          p[i].termino = -1;
      }
  
-     printf("\n--- Executando Escalonamento SJF Não Preemptivo ---\n");
+     // Índices dos processos ordenados por chegada (desempate pelo ID): as chegadas
+     // são consumidas por um cursor, sem varrer todos os processos a cada decisão.
+     ordem_chegada = (int *)malloc(n * sizeof(int));
+     if (ordem_chegada == NULL) {
+         fprintf(stderr, "Erro: Falha na alocação de memória para a ordem de chegada!\n");
+         return abortar_simulacao(p, ordem_chegada, &rastro);
+     }
+     for (i = 0; i < n; i++) {
+         ordem_chegada[i] = i;
+     }
+     if (ordenar_por_chegada(ordem_chegada, n, p) != 0) {
+         fprintf(stderr, "Erro: Falha na alocação de memória para a ordem de chegada!\n");
+         return abortar_simulacao(p, ordem_chegada, &rastro);
+     }
+ 
+     // Heap de prontos ordenado por duração -> chegada -> ID (SRTF: tempo restante -> chegada -> ID)
+     if (heap_criar(&prontos, n, preemptivo ? comparar_restante : comparar_duracao, p) != 0) {
+         fprintf(stderr, "Erro: Falha na alocação de memória para a fila de prontos!\n");
+         return abortar_simulacao(p, ordem_chegada, &rastro);
+     }
  
-     // Loop principal: executa até todos os processos serem finalizados
-     while (processos_finalizados < n) {
-         int idx_selecionado = -1;   // Índice do processo selecionado para execução
-         int menor_duracao_atual = -1; // Menor duração encontrada entre os processos prontos
+     hist_iniciar(&hist_espera);
+     hist_iniciar(&hist_retorno);
  
-         // Busca o processo disponível (chegou e não finalizado) com menor duração
-         for (i = 0; i < n; i++) {
-             if (!p[i].finalizado && p[i].chegada <= tempo_atual) {
-                 if (idx_selecionado == -1 || p[i].duracao < menor_duracao_atual) {
-                     menor_duracao_atual = p[i].duracao;
-                     idx_selecionado = i;
-                 }
-                 // Critério de desempate (opcional): se durações iguais, menor tempo de chegada
-                 else if (p[i].duracao == menor_duracao_atual) {
-                     if (p[i].chegada < p[idx_selecionado].chegada) {
-                         idx_selecionado = i;
-                     }
-                     // Outro desempate (opcional): se chegada também igual, menor ID
-                     else if (p[i].chegada == p[idx_selecionado].chegada && p[i].id < p[idx_selecionado].id) {
-                          idx_selecionado = i;
-                     }
-                 }
+     printf("\n--- Executando Escalonamento %s ---\n", nome_algoritmo);
+ 
+     // SRTF orientado a eventos: o processo com menor tempo restante executa até terminar
+     // ou até a próxima chegada, quando a escolha é refeita (preempção só nas chegadas)
+     while (preemptivo && processos_finalizados < n) {
+         int idx_selecionado, proximo_evento;
+ 
+         while (proxima_chegada < n && p[ordem_chegada[proxima_chegada]].chegada <= tempo_atual) {
+             heap_inserir_restante(&prontos, ordem_chegada[proxima_chegada]);
+             RASTRAR(&rastro, p[ordem_chegada[proxima_chegada]].chegada, p[ordem_chegada[proxima_chegada]].id, RASTRO_CHEGADA);
+             proxima_chegada++;
+         }
+ 
+         // O processo pronto com menor tempo restante fica no topo do heap (sem sair dele)
+         idx_selecionado = heap_topo(&prontos);
+         if (idx_selecionado == -1) { // CPU ociosa: salta para a próxima chegada
+             tempo_atual = p[ordem_chegada[proxima_chegada]].chegada;
+             ultimo_executado = -1;
+             continue;
+         }
+         if (p[idx_selecionado].inicio == -1) {
+             p[idx_selecionado].inicio = tempo_atual;
+         }
+         if (idx_selecionado != ultimo_executado) {
+             if (ultimo_executado != -1) {
+                 preempcoes++; // O processo anterior ainda não tinha terminado
+                 RASTRAR(&rastro, tempo_atual, p[ultimo_executado].id, RASTRO_PREEMPCAO);
              }
+             RASTRAR(&rastro, tempo_atual, p[idx_selecionado].id, RASTRO_EXECUCAO);
+             ultimo_executado = idx_selecionado;
          }
  
+         // Executa até o término ou até a próxima chegada, o que vier primeiro
+         proximo_evento = tempo_atual + p[idx_selecionado].restante;
+         if (proxima_chegada < n && p[ordem_chegada[proxima_chegada]].chegada < proximo_evento) {
+             proximo_evento = p[ordem_chegada[proxima_chegada]].chegada;
+         }
+         p[idx_selecionado].restante -= proximo_evento - tempo_atual;
+         tempo_atual = proximo_evento;
+ 
+         if (p[idx_selecionado].restante == 0) {
+             heap_remover_restante(&prontos, idx_selecionado);
+             p[idx_selecionado].termino = tempo_atual;
+             p[idx_selecionado].retorno = p[idx_selecionado].termino - p[idx_selecionado].chegada;
+             p[idx_selecionado].espera = p[idx_selecionado].retorno - p[idx_selecionado].duracao;
+             p[idx_selecionado].finalizado = 1;
+             processos_finalizados++;
+             ultimo_executado = -1;
+             RASTRAR(&rastro, tempo_atual, p[idx_selecionado].id, RASTRO_TERMINO);
+ 
+             // Registra nos histogramas (médias e percentis)
+             hist_registrar(&hist_espera, p[idx_selecionado].espera);
+             hist_registrar(&hist_retorno, p[idx_selecionado].retorno);
+         } else {
+             heap_atualizar_restante(&prontos, idx_selecionado); // O tempo restante diminuiu
+         }
+     }
+ 
+     // Loop principal (não preemptivo): executa até todos os processos serem finalizados
+     while (processos_finalizados < n) {
+         int idx_selecionado;   // Índice do processo selecionado para execução
+ 
+         // Processos que chegaram até o tempo atual entram no heap de prontos
+         while (proxima_chegada < n && p[ordem_chegada[proxima_chegada]].chegada <= tempo_atual) {
+             heap_inserir_duracao(&prontos, ordem_chegada[proxima_chegada]);
+             RASTRAR(&rastro, p[ordem_chegada[proxima_chegada]].chegada, p[ordem_chegada[proxima_chegada]].id, RASTRO_CHEGADA);
+             proxima_chegada++;
+         }
+ 
+         // O topo do heap é o processo pronto com menor duração
+         idx_selecionado = heap_remover_topo_duracao(&prontos);
+ 
          // Se nenhum processo está pronto (CPU Ociosa)
          if (idx_selecionado == -1) {
-             if (processos_finalizados == n) { // Todos já finalizaram, sair do loop
+             if (proxima_chegada == n) { // Não há mais chegadas: todos já finalizaram
                  break;
              }
-             int proxima_chegada_minima = -1;
-             int encontrou_proximo = 0;
- 
              // Avança o tempo para o próximo processo que irá chegar
-             for (i = 0; i < n; i++) {
-                 if (!p[i].finalizado) { // Considera apenas os não finalizados
-                     if (!encontrou_proximo || p[i].chegada < proxima_chegada_minima) {
-                         proxima_chegada_minima = p[i].chegada;
-                         encontrou_proximo = 1;
-                     }
-                 }
-             }
- 
-             if (encontrou_proximo) { // Se há processos futuros
-                 if (tempo_atual < proxima_chegada_minima) { // Avança o tempo se a chegada for no futuro
-                     tempo_atual = proxima_chegada_minima;
-                 } else {
-                     // Se o próximo a chegar já chegou ou está no tempo atual,
-                     // mas não foi selecionado, algo está estranho (idx_selecionado deveria ter sido definido).
-                     // Para garantir progresso caso a lógica de seleção tenha uma condição limite,
-                     // avançamos o tempo minimamente.
-                     tempo_atual++;
-                 }
-             } else {
-                 // Nenhum processo não finalizado restante. Isso significa que processos_finalizados == n.
-                 // O loop while deve terminar. Se não, é um erro de estado.
-                 if (processos_finalizados < n) {
-                    fprintf(stderr, "Alerta: CPU ociosa, mas há processos não finalizados sem chegadas futuras.\n");
-                     // Isso pode indicar um problema se o loop não terminar.
-                     // Por segurança, apenas avançar o tempo para tentar novamente.
-                     tempo_atual++;
-                 } else {
-                     break; // Todos os processos foram contabilizados como finalizados.
-                 }
-             }
+             tempo_atual = p[ordem_chegada[proxima_chegada]].chegada;
              continue; // Volta ao início do loop para reavaliar com o novo tempo_atual
          }
  
@@ -158,39 +364,54 @@
          tempo_atual = p[idx_selecionado].termino; // Atualiza o tempo global
          p[idx_selecionado].finalizado = 1;
          processos_finalizados++;
+         RASTRAR(&rastro, p[idx_selecionado].inicio, p[idx_selecionado].id, RASTRO_EXECUCAO);
+         RASTRAR(&rastro, tempo_atual, p[idx_selecionado].id, RASTRO_TERMINO);
  
-         // Acumula para cálculo das médias
-         soma_espera += p[idx_selecionado].espera;
-         soma_retorno += p[idx_selecionado].retorno;
+         // Registra nos histogramas (médias e percentis)
+         hist_registrar(&hist_espera, p[idx_selecionado].espera);
+         hist_registrar(&hist_retorno, p[idx_selecionado].retorno);
      }
  
-     // Exibe os resultados
-     printf("\n--- Resultados do Escalonamento SJF Não Preemptivo ---\n");
-     printf("+-----+---------+---------+--------+---------+--------+---------+\n");
-     printf("| %-3s | %-7s | %-7s | %-6s | %-7s | %-6s | %-7s |\n",
-            "ID", "Chegada", "Duração", "Início", "Término", "Espera", "Retorno");
-     printf("+-----+---------+---------+--------+---------+--------+---------+\n");
+     if (arquivo_rastro != NULL) {
+         long long eventos = rastro.total;
+         if (rastro_fechar(&rastro) != 0) {
+             status = 1;
+         } else {
+             printf("Rastro de execução: %lld eventos gravados em '%s'.\n", eventos, arquivo_rastro);
+         }
+     }
  
-     for (i = 0; i < n; i++) {
-         printf("| %-3d | %-7d | %-7d | %-6d | %-7d | %-6d | %-7d |\n",
-                p[i].id, p[i].chegada, p[i].duracao,
-                p[i].inicio, p[i].termino, p[i].espera, p[i].retorno);
+     // Exibe os resultados
+     // Formato padrão: tabela para execuções pequenas, apenas o resumo para as grandes
+     if (!formato_definido) {
+         formato_saida = saida_formato_padrao(n);
+     }
+     printf("\n--- Resultados do Escalonamento %s ---\n", nome_algoritmo);
+     if (exibir_resultados(p, n, formato_saida, arquivo_saida) != 0) {
+         status = 1;
      }
-     printf("+-----+---------+---------+--------+---------+--------+---------+\n");
  
      if (n > 0) { // Evita divisão por zero
-         printf("\nTempo médio de espera: %.2f unidades de tempo\n", soma_espera / n);
-         printf("Tempo médio de retorno: %.2f unidades de tempo\n", soma_retorno / n);
+         printf("\nTempo médio de espera: %.2f unidades de tempo\n", hist_media(&hist_espera));
+         printf("Tempo médio de retorno: %.2f unidades de tempo\n", hist_media(&hist_retorno));
+         hist_exibir_percentis("espera", &hist_espera);
+         hist_exibir_percentis("retorno", &hist_retorno);
+         if (preemptivo) {
+             printf("Preempções: %ld\n", preempcoes);
+         }
      }
-     printf("\nSimulação SJF Não Preemptivo concluída.\n");
+     printf("\nSimulação %s concluída.\n", nome_algoritmo);
  
      // --- LIBERAÇÃO DA MEMÓRIA DINÂMICA ---
+     heap_destruir(&prontos);
+     free(ordem_chegada);
+     ordem_chegada = NULL;
      if (p != NULL) {
          free(p);
          p = NULL; // Boa prática
      }
      // --- FIM DA LIBERAÇÃO ---
  
-     return 0;
+     return status;
  }
  
\ No newline at end of file
@@ -0,0 +1,164 @@
+/*
+ * Varredura de Quantum do Round Robin
+ * Este programa simula o Round Robin para uma faixa de valores de quantum sobre a
+ * mesma carga de trabalho, lida uma única vez e compartilhada (somente leitura) por
+ * todas as threads. Cada thread reaproveita o próprio Resultado e pega o próximo
+ * quantum ainda não simulado; ao final é exibida uma tabela com espera média,
+ * p99 da espera, retorno médio e trocas de contexto para cada quantum.
+ *
+ * Compilação: gcc -O2 -pthread -o varredura_quantum varredura_quantum.c motor.c
+ * Uso: ./varredura_quantum -q inicio:fim[:passo] [-e arquivo_de_carga] [-t threads]
+ *   -q: faixa de quanta a simular (por exemplo, 1:100 ou 5:200:5)
+ *   -e: lê os processos de um arquivo (CSV ou binário, ver carga.h)
+ *   -t: número de threads (padrão: número de núcleos disponíveis)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>  // Para malloc, free, atoi
+#include <unistd.h>  // Para getopt, sysconf
+#include <pthread.h> // Para pthread_create, pthread_join, pthread_mutex_t
+#include "motor.h"
+
+// Métricas de uma simulação (uma por quantum)
+typedef struct {
+    int quantum;
+    double media_espera;
+    long long p99_espera;
+    double media_retorno;
+    long trocas_contexto;
+} PontoVarredura;
+
+// Estado compartilhado entre as threads da varredura
+typedef struct {
+    const CargaTrabalho *carga;   // Carga imutável, lida por todas as threads
+    PontoVarredura *pontos;       // Um por quantum; cada posição é escrita por uma única thread
+    int total;                    // Quantidade de quanta
+    int proximo;                  // Próximo quantum a simular (protegido por trava)
+    int erro;                     // 1 se alguma thread ficou sem memória
+    pthread_mutex_t trava;
+} Varredura;
+
+void *trabalhador(void *arg) {
+    Varredura *v = (Varredura *)arg;
+    Resultado res;
+
+    if (motor_preparar_resultado(&res, v->carga, &politica_rr, 0) != 0) {
+        pthread_mutex_lock(&v->trava);
+        v->erro = 1;
+        pthread_mutex_unlock(&v->trava);
+        return NULL;
+    }
+    for (;;) {
+        int k;
+        pthread_mutex_lock(&v->trava);
+        k = v->proximo < v->total && !v->erro ? v->proximo++ : -1;
+        pthread_mutex_unlock(&v->trava);
+        if (k == -1) break;
+
+        res.parametro = v->pontos[k].quantum;
+        if (motor_executar(v->carga, &res) != 0) {
+            pthread_mutex_lock(&v->trava);
+            v->erro = 1;
+            pthread_mutex_unlock(&v->trava);
+            break;
+        }
+        v->pontos[k].media_espera = (double)res.soma_espera / v->carga->n;
+        v->pontos[k].p99_espera = hist_percentil(&res.hist_espera, 99.0);
+        v->pontos[k].media_retorno = (double)res.soma_retorno / v->carga->n;
+        v->pontos[k].trocas_contexto = res.trocas_contexto;
+    }
+    motor_liberar_resultado(&res);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    CargaTrabalho carga;
+    Varredura v;
+    pthread_t *threads;
+    const char *arquivo_entrada = NULL;
+    int q_inicio = 0, q_fim = 0, q_passo = 1;
+    int n_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int opcao, k, criadas;
+
+    while ((opcao = getopt(argc, argv, "e:q:t:")) != -1) {
+        switch (opcao) {
+        case 'e':
+            arquivo_entrada = optarg;
+            break;
+        case 'q':
+            if (sscanf(optarg, "%d:%d:%d", &q_inicio, &q_fim, &q_passo) < 2) {
+                q_inicio = 0; // Formato inválido, tratado abaixo
+            }
+            break;
+        case 't':
+            n_threads = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Uso: %s -q inicio:fim[:passo] [-e arquivo_de_carga] [-t threads]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (q_inicio <= 0 || q_fim < q_inicio || q_passo <= 0) {
+        fprintf(stderr, "Erro: Informe a faixa de quanta com -q inicio:fim[:passo] (valores positivos, inicio <= fim).\n");
+        return 1;
+    }
+    if (n_threads <= 0) n_threads = 1;
+
+    printf("Varredura de Quantum do Round Robin\n");
+    printf("-----------------------------------\n");
+
+    if (motor_carregar(&carga, arquivo_entrada) != 0) {
+        return 1;
+    }
+
+    v.carga = &carga;
+    v.total = (q_fim - q_inicio) / q_passo + 1;
+    v.proximo = 0;
+    v.erro = 0;
+    v.pontos = (PontoVarredura *)malloc(v.total * sizeof(PontoVarredura));
+    threads = (pthread_t *)malloc(n_threads * sizeof(pthread_t));
+    if (v.pontos == NULL || threads == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória para a varredura!\n");
+        free(v.pontos);
+        free(threads);
+        motor_liberar_carga(&carga);
+        return 1;
+    }
+    for (k = 0; k < v.total; k++) {
+        v.pontos[k].quantum = q_inicio + k * q_passo;
+    }
+    pthread_mutex_init(&v.trava, NULL);
+
+    if (n_threads > v.total) n_threads = v.total;
+    printf("\nSimulando %d valores de quantum com %d threads...\n", v.total, n_threads);
+    for (criadas = 0; criadas < n_threads; criadas++) {
+        if (pthread_create(&threads[criadas], NULL, trabalhador, &v) != 0) break;
+    }
+    if (criadas == 0) {
+        trabalhador(&v); // Sem threads extras: simula tudo na thread principal
+    }
+    for (k = 0; k < criadas; k++) {
+        pthread_join(threads[k], NULL);
+    }
+    pthread_mutex_destroy(&v.trava);
+
+    if (v.erro) {
+        fprintf(stderr, "Erro: Falha de memória durante a varredura.\n");
+    } else {
+        printf("\n--- Resultados da Varredura (%d processos) ---\n", carga.n);
+        printf("+---------+----------------+-------------+----------------+--------------------+\n");
+        printf("| %-7s | %-14s | %-11s | %-14s | %-18s |\n", "Quantum", "Espera média", "Espera p99", "Retorno médio", "Trocas de contexto");
+        printf("+---------+----------------+-------------+----------------+--------------------+\n");
+        for (k = 0; k < v.total; k++) {
+            printf("| %-7d | %14.2f | %11lld | %14.2f | %18ld |\n", v.pontos[k].quantum,
+                   v.pontos[k].media_espera, v.pontos[k].p99_espera, v.pontos[k].media_retorno, v.pontos[k].trocas_contexto);
+        }
+        printf("+---------+----------------+-------------+----------------+--------------------+\n");
+        printf("\nVarredura concluída.\n");
+    }
+
+    free(v.pontos);
+    free(threads);
+    motor_liberar_carga(&carga);
+    return v.erro ? 1 : 0;
+}